@@ -7,6 +7,7 @@
 #include "driver/statement.h"
 
 #include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Timezone.h>
 
 #include <exception>
 #include <type_traits>
@@ -173,6 +174,7 @@ SQLRETURN SetConnectAttr(
 
             case SQL_ATTR_CURRENT_CATALOG:
                 connection.database = toUTF8(static_cast<PTChar*>(value), value_length / sizeof(PTChar));
+                connection.updateRequestTemplate();
                 return SQL_SUCCESS;
 
             case SQL_ATTR_ANSI_APP:
@@ -199,6 +201,7 @@ SQLRETURN SetConnectAttr(
 #if defined(SQL_APPLICATION_NAME)
             case SQL_APPLICATION_NAME:
                 connection.useragent = toUTF8((SQLTCHAR *)value, value_length / sizeof(SQLTCHAR));
+                connection.updateRequestTemplate();
                 LOG("SetConnectAttr: SQL_APPLICATION_NAME: " << connection.useragent);
                 return SQL_SUCCESS;
 #endif
@@ -207,8 +210,11 @@ SQLRETURN SetConnectAttr(
                 connection.setAttr(SQL_ATTR_METADATA_ID, value);
                 return SQL_SUCCESS;
 
-            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_ASYNC_ENABLE:
+                connection.setAttr(SQL_ATTR_ASYNC_ENABLE, value);
+                return SQL_SUCCESS;
+
+            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_AUTO_IPD:
             case SQL_ATTR_AUTOCOMMIT:
             case SQL_ATTR_CONNECTION_DEAD:
@@ -277,8 +283,13 @@ SQLRETURN GetConnectAttr(
                     out_value, out_value_length
                 );
 
-            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_ASYNC_ENABLE:
+                return fillOutputPOD<SQLULEN>(
+                    connection.getAttrAs<SQLULEN>(SQL_ATTR_ASYNC_ENABLE, SQL_ASYNC_ENABLE_OFF),
+                    out_value, out_value_length
+                );
+
+            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_AUTO_IPD:
             case SQL_ATTR_ODBC_CURSORS:
             case SQL_ATTR_PACKET_SIZE:
@@ -396,6 +407,18 @@ SQLRETURN SetStmtAttr(
                 statement.setAttr(SQL_ATTR_METADATA_ID, value);
                 return SQL_SUCCESS;
 
+            case SQL_ATTR_MAX_ROWS:
+                statement.setAttr(SQL_ATTR_MAX_ROWS, value);
+                return SQL_SUCCESS;
+
+            case SQL_ATTR_QUERY_TIMEOUT:
+                statement.setAttr(SQL_ATTR_QUERY_TIMEOUT, value);
+                return SQL_SUCCESS;
+
+            case SQL_ATTR_ASYNC_ENABLE:
+                statement.setAttr(SQL_ATTR_ASYNC_ENABLE, value);
+                return SQL_SUCCESS;
+
             case SQL_ATTR_APP_ROW_DESC:
             case SQL_ATTR_APP_PARAM_DESC:
             case SQL_ATTR_IMP_ROW_DESC:
@@ -404,15 +427,12 @@ SQLRETURN SetStmtAttr(
 
             case SQL_ATTR_CURSOR_SCROLLABLE:
             case SQL_ATTR_CURSOR_SENSITIVITY:
-            case SQL_ATTR_ASYNC_ENABLE:
             case SQL_ATTR_CONCURRENCY:
             case SQL_ATTR_CURSOR_TYPE: /// Libreoffice Base
             case SQL_ATTR_ENABLE_AUTO_IPD:
             case SQL_ATTR_FETCH_BOOKMARK_PTR:
             case SQL_ATTR_KEYSET_SIZE:
             case SQL_ATTR_MAX_LENGTH:
-            case SQL_ATTR_MAX_ROWS:
-            case SQL_ATTR_QUERY_TIMEOUT:
             case SQL_ATTR_RETRIEVE_DATA:
             case SQL_ATTR_ROW_NUMBER:
             case SQL_ATTR_SIMULATE_CURSOR:
@@ -471,12 +491,20 @@ SQLRETURN GetStmtAttr(
 
             CASE_NUM(SQL_ATTR_CURSOR_SCROLLABLE, SQLULEN, SQL_NONSCROLLABLE);
             CASE_NUM(SQL_ATTR_CURSOR_SENSITIVITY, SQLULEN, SQL_INSENSITIVE);
-            CASE_NUM(SQL_ATTR_ASYNC_ENABLE, SQLULEN, SQL_ASYNC_ENABLE_OFF);
+            CASE_FALLTHROUGH(SQL_ATTR_ASYNC_ENABLE)
+                return fillOutputPOD<SQLULEN>(
+                    statement.getAttrAs<SQLULEN>(
+                        SQL_ATTR_ASYNC_ENABLE,
+                        statement.getParent().getAttrAs<SQLULEN>(SQL_ATTR_ASYNC_ENABLE, SQL_ASYNC_ENABLE_OFF)
+                    ),
+                    out_value, out_value_length
+                );
+
             CASE_NUM(SQL_ATTR_CONCURRENCY, SQLULEN, SQL_CONCUR_READ_ONLY);
             CASE_NUM(SQL_ATTR_CURSOR_TYPE, SQLULEN, SQL_CURSOR_FORWARD_ONLY);
             CASE_NUM(SQL_ATTR_ENABLE_AUTO_IPD, SQLULEN, SQL_FALSE);
             CASE_NUM(SQL_ATTR_MAX_LENGTH, SQLULEN, 0);
-            CASE_NUM(SQL_ATTR_MAX_ROWS, SQLULEN, 0);
+            CASE_NUM(SQL_ATTR_MAX_ROWS, SQLULEN, statement.getAttrAs<SQLULEN>(SQL_ATTR_MAX_ROWS, 0));
 
             CASE_FALLTHROUGH(SQL_ATTR_METADATA_ID)
                 return fillOutputPOD<SQLULEN>(
@@ -501,7 +529,7 @@ SQLRETURN GetStmtAttr(
                 return fillOutputPOD<SQLULEN>(result_set.getCurrentRowPosition(), out_value, out_value_length);
             }
 
-            CASE_NUM(SQL_ATTR_QUERY_TIMEOUT, SQLULEN, 0);
+            CASE_NUM(SQL_ATTR_QUERY_TIMEOUT, SQLULEN, statement.getAttrAs<SQLULEN>(SQL_ATTR_QUERY_TIMEOUT, 0));
             CASE_NUM(SQL_ATTR_RETRIEVE_DATA, SQLULEN, SQL_RD_ON);
             CASE_NUM(SQL_ATTR_USE_BOOKMARKS, SQLULEN, SQL_UB_OFF);
 
@@ -897,6 +925,42 @@ SQLRETURN DescribeParam(
         if (parameter_number < 0 || parameter_number > ipd_desc.getRecordCount())
             throw SqlException("Invalid descriptor index", "07009");
 
+        // The parameters inserted into, or compared with, table columns are described as these columns, if their types are inferred.
+        const auto & column_types = statement.getParamColumnTypes();
+        if (parameter_number > 0 && parameter_number <= column_types.size() && !column_types[parameter_number - 1].empty()) {
+            const auto & column_type = column_types[parameter_number - 1];
+
+            TypeAst ast;
+            ColumnInfo column_info;
+
+            if (TypeParser{column_type}.parse(&ast)) {
+                try {
+                    column_info.assignTypeInfo(ast, Poco::Timezone::name());
+                }
+                catch (const std::exception &) {
+                    column_info = ColumnInfo{};
+                }
+
+                // Types that have no ODBC counterpart are reported as String, as by SQLColumns.
+                if (convertUnparametrizedTypeNameToTypeId(column_info.type_without_parameters) == DataSourceTypeId::Unknown)
+                    column_info.type_without_parameters = "String";
+
+                const auto & type_info = statement.getTypeInfo(column_info.type, column_info.type_without_parameters);
+
+                if (out_data_type_ptr)
+                    *out_data_type_ptr = type_info.data_type;
+                if (out_parameter_size_ptr)
+                    *out_parameter_size_ptr = std::min<int32_t>(
+                        statement.getParent().stringmaxlength, column_info.fixed_size ? column_info.fixed_size : type_info.column_size);
+                if (out_decimal_digits_ptr)
+                    *out_decimal_digits_ptr = column_info.scale;
+                if (out_nullable_ptr)
+                    *out_nullable_ptr = (column_info.is_nullable ? SQL_NULLABLE : SQL_NO_NULLS);
+
+                return SQL_SUCCESS;
+            }
+        }
+
         auto & ipd_record = ipd_desc.getRecord(parameter_number, SQL_ATTR_IMP_PARAM_DESC);
 
         *out_data_type_ptr = ipd_record.getAttrAs<SQLSMALLINT>(SQL_DESC_CONCISE_TYPE);
@@ -1234,13 +1298,18 @@ SQLRETURN EndTran(
     SQLSMALLINT     completion_type
 ) noexcept {
     auto func = [&] (auto & object) {
+        using ObjectType = std::decay_t<decltype(object)>;
 
-        // TODO: implement.
+        // Transactions are not supported, every execution is committed on its own. But the rows of INSERT executions
+        // that are still buffered on the client are sent now, so that they are in the table when this returns.
+        if constexpr (std::is_same_v<ObjectType, Environment> || std::is_same_v<ObjectType, Connection>) {
+            object.flushInsertBatches();
+        }
 
         return SQL_SUCCESS;
     };
 
-    return CALL_WITH_TYPED_HANDLE_SKIP_DIAG(handle_type, handle, func);
+    return CALL_WITH_TYPED_HANDLE(handle_type, handle, func);
 }
 
 SQLRETURN fillBinding(
@@ -1315,7 +1384,14 @@ SQLRETURN fetchBindings(
     }
 
     auto & result_set = statement.getResultSet();
-    const auto rows_fetched = result_set.fetchRowSet(orientation, offset, row_set_size);
+
+    // The server is asked to stop producing rows after SQL_ATTR_MAX_ROWS, but the limit is enforced here too, in case it doesn't support that.
+    auto fetch_size = row_set_size;
+    const auto max_rows = statement.getAttrAs<SQLULEN>(SQL_ATTR_MAX_ROWS, 0);
+    if (max_rows > 0)
+        fetch_size = std::min<SQLULEN>(fetch_size, max_rows - std::min<SQLULEN>(max_rows, result_set.getAffectedRowCount()));
+
+    const auto rows_fetched = result_set.fetchRowSet(orientation, offset, fetch_size);
 
     if (rows_fetched == 0) {
         statement.getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, result_set.getAffectedRowCount());
@@ -1375,15 +1451,7 @@ SQLRETURN fetchBindings(
                 base_binding.value_size ||
                 base_binding.indicator
             ) { // Only if the column is bound...
-                const auto next_value_ptr_increment = (bind_type == SQL_BIND_BY_COLUMN ? base_binding.value_max_size : bind_type);
-                const auto next_sz_ind_ptr_increment = (bind_type == SQL_BIND_BY_COLUMN ? sizeof(SQLLEN) : bind_type);
-
-                BindingInfo binding_info;
-                binding_info.c_type = base_binding.c_type;
-                binding_info.value_max_size = base_binding.value_max_size;
-                binding_info.value = (SQLPOINTER)(base_binding.value ? ((char *)(base_binding.value) + row_idx * next_value_ptr_increment + bind_offset) : 0);
-                binding_info.value_size = (SQLLEN *)(base_binding.value_size ? ((char *)(base_binding.value_size) + row_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
-                binding_info.indicator = (SQLLEN *)(base_binding.indicator ? ((char *)(base_binding.indicator) + row_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
+                auto binding_info = getRowBinding(base_binding, row_idx, bind_type, bind_offset);
 
                 // TODO: fill per-row and per-column diagnostics on (some soft?) errors.
                 const auto code = fillBinding(
@@ -1479,10 +1547,12 @@ SQLRETURN Fetch(
     SQLHSTMT       StatementHandle
 ) noexcept {
     auto func = [&] (Statement & statement) {
-        return fetchBindings(statement, SQL_FETCH_NEXT, 0);
+        return statement.callAsync(SQL_API_SQLFETCH, [&statement] () {
+            return fetchBindings(statement, SQL_FETCH_NEXT, 0);
+        });
     };
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, func);
+    return CALL_WITH_TYPED_HANDLE_ASYNC(SQL_HANDLE_STMT, StatementHandle, func);
 }
 
 SQLRETURN FetchScroll(
@@ -1491,10 +1561,30 @@ SQLRETURN FetchScroll(
     SQLLEN        FetchOffset
 ) noexcept {
     auto func = [&] (Statement & statement) {
-        return fetchBindings(statement, FetchOrientation, FetchOffset);
+        return statement.callAsync(SQL_API_SQLFETCHSCROLL, [&statement, FetchOrientation, FetchOffset] () {
+            return fetchBindings(statement, FetchOrientation, FetchOffset);
+        });
     };
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, func);
+    return CALL_WITH_TYPED_HANDLE_ASYNC(SQL_HANDLE_STMT, StatementHandle, func);
+}
+
+SQLRETURN BulkOperations(
+    SQLHSTMT       StatementHandle,
+    SQLSMALLINT    Operation
+) noexcept {
+    auto func = [&] (Statement & statement) {
+        if (Operation != SQL_ADD)
+            throw SqlException("Optional feature not implemented", "HYC00");
+
+        return statement.callAsync(SQL_API_SQLBULKOPERATIONS, [&statement] () -> SQLRETURN {
+            const auto row_count = statement.bulkAdd();
+            statement.getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, row_count);
+            return SQL_SUCCESS;
+        });
+    };
+
+    return CALL_WITH_TYPED_HANDLE_ASYNC(SQL_HANDLE_STMT, StatementHandle, func);
 }
 
 SQLRETURN getServerVersion(
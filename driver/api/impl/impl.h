@@ -204,6 +204,11 @@ namespace impl {
         SQLLEN        FetchOffset
     ) noexcept;
 
+    SQLRETURN BulkOperations(
+        SQLHSTMT       StatementHandle,
+        SQLSMALLINT    Operation
+    ) noexcept;
+
     SQLRETURN getServerVersion(
          SQLHDBC         conn,
          SQLPOINTER      buffer_ptr,
@@ -76,7 +76,7 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLFreeStmt)(HSTMT statement_handle, SQLUSMA
     return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement_handle, [&] (Statement & statement) -> SQLRETURN {
         switch (option) {
             case SQL_CLOSE: /// Close the cursor, ignore the remaining results. If there is no cursor, then noop.
-                statement.closeCursor();
+                statement.closeCursor(); /// The INSERT rows buffered by the statement stay in the batches of the connection, so that the next executions can add to them.
                 return SQL_SUCCESS;
 
             case SQL_DROP:
@@ -176,7 +176,8 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetInfo)(
 
             /// UINTEGER single values
             CASE_NUM(SQL_ODBC_INTERFACE_CONFORMANCE, SQLUINTEGER, SQL_OIC_CORE)
-            CASE_NUM(SQL_ASYNC_MODE, SQLUINTEGER, SQL_AM_NONE)
+            CASE_NUM(SQL_ASYNC_MODE, SQLUINTEGER, SQL_AM_STATEMENT)
+            CASE_NUM(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1, SQLUINTEGER, SQL_CA1_BULK_ADD)
 #if defined(SQL_ASYNC_NOTIFICATION)
             CASE_NUM(SQL_ASYNC_NOTIFICATION, SQLUINTEGER, SQL_ASYNC_NOTIFICATION_NOT_CAPABLE)
 #endif
@@ -346,7 +347,6 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetInfo)(
             CASE_FALLTHROUGH(SQL_DROP_TRANSLATION)
             CASE_FALLTHROUGH(SQL_DYNAMIC_CURSOR_ATTRIBUTES1)
             CASE_FALLTHROUGH(SQL_DYNAMIC_CURSOR_ATTRIBUTES2)
-            CASE_FALLTHROUGH(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1)
             CASE_FALLTHROUGH(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2)
             CASE_FALLTHROUGH(SQL_KEYSET_CURSOR_ATTRIBUTES1)
             CASE_FALLTHROUGH(SQL_KEYSET_CURSOR_ATTRIBUTES2)
@@ -506,19 +506,26 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLPrepare)(HSTMT statement_handle,
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLExecute)(HSTMT statement_handle) {
     LOG(__FUNCTION__);
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
-        statement.executeQuery();
-        return SQL_SUCCESS;
+    return CALL_WITH_TYPED_HANDLE_ASYNC(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
+        return statement.callAsync(SQL_API_SQLEXECUTE, [&statement] () {
+            statement.executeQuery();
+            return (statement.needsData() ? SQL_NEED_DATA : SQL_SUCCESS);
+        });
     });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLExecDirect)(HSTMT statement_handle, SQLTCHAR * statement_text, SQLINTEGER statement_text_size) {
     //LOG(__FUNCTION__ << " statement_text_size=" << statement_text_size << " statement_text=" << statement_text);
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
-        const auto query = toUTF8(statement_text, statement_text_size);
-        statement.executeQuery(query);
-        return SQL_SUCCESS;
+    return CALL_WITH_TYPED_HANDLE_ASYNC(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
+        // The query is prepared on the calling thread, only its execution runs asynchronously, and the repeated calls poll it.
+        if (!statement.isAsyncInProgress())
+            statement.prepareQuery(toUTF8(statement_text, statement_text_size));
+
+        return statement.callAsync(SQL_API_SQLEXECDIRECT, [&statement] () {
+            statement.executeQuery();
+            return (statement.needsData() ? SQL_NEED_DATA : SQL_SUCCESS);
+        });
     });
 }
 
@@ -789,6 +796,8 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLMoreResults)(HSTMT statement_handle) {
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLDisconnect)(HDBC connection_handle) {
     LOG(__FUNCTION__);
     return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_DBC, connection_handle, [&](Connection & connection) {
+        connection.stopInsertFlusher();
+        connection.flushInsertBatches();
         connection.session->reset();
         return SQL_SUCCESS;
     });
@@ -1188,11 +1197,13 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLCancel)(
     SQLHSTMT     StatementHandle
 ) {
     auto func = [&] (Statement & statement) {
-        statement.closeCursor();
+        // An asynchronous operation is only flagged here, the worker thread stops it and the next poll closes the cursor.
+        if (!statement.cancelAsync())
+            statement.closeCursor();
         return SQL_SUCCESS;
     };
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, func);
+    return CALL_WITH_TYPED_HANDLE_ASYNC(SQL_HANDLE_STMT, StatementHandle, func);
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetCursorName)(
@@ -1218,14 +1229,14 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLGetFunctions)(HDBC connection_handle, SQL
             SET_EXISTS(SQL_API_SQLBINDPARAM);
 #endif
             //SET_EXISTS(SQL_API_SQLBROWSECONNECT);
-            //SET_EXISTS(SQL_API_SQLBULKOPERATIONS);
+            SET_EXISTS(SQL_API_SQLBULKOPERATIONS);
             SET_EXISTS(SQL_API_SQLCANCEL);
             //SET_EXISTS(SQL_API_SQLCANCELHANDLE);
             SET_EXISTS(SQL_API_SQLCLOSECURSOR);
             SET_EXISTS(SQL_API_SQLCOLATTRIBUTE);
             //SET_EXISTS(SQL_API_SQLCOLUMNPRIVILEGES);
             SET_EXISTS(SQL_API_SQLCOLUMNS);
-            //SET_EXISTS(SQL_API_SQLCOMPLETEASYNC);
+            SET_EXISTS(SQL_API_SQLCOMPLETEASYNC);
             SET_EXISTS(SQL_API_SQLCONNECT);
             SET_EXISTS(SQL_API_SQLCOPYDESC);
             SET_EXISTS(SQL_API_SQLDESCRIBECOL);
@@ -1257,12 +1268,12 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLGetFunctions)(HDBC connection_handle, SQL
             SET_EXISTS(SQL_API_SQLNATIVESQL);
             SET_EXISTS(SQL_API_SQLNUMPARAMS);
             SET_EXISTS(SQL_API_SQLNUMRESULTCOLS);
-            //SET_EXISTS(SQL_API_SQLPARAMDATA);
+            SET_EXISTS(SQL_API_SQLPARAMDATA);
             SET_EXISTS(SQL_API_SQLPREPARE);
             //SET_EXISTS(SQL_API_SQLPRIMARYKEYS);
             //SET_EXISTS(SQL_API_SQLPROCEDURECOLUMNS);
             //SET_EXISTS(SQL_API_SQLPROCEDURES);
-            //SET_EXISTS(SQL_API_SQLPUTDATA);
+            SET_EXISTS(SQL_API_SQLPUTDATA);
             SET_EXISTS(SQL_API_SQLROWCOUNT);
             SET_EXISTS(SQL_API_SQLSETCONNECTATTR);
             //SET_EXISTS(SQL_API_SQLSETCURSORNAME);
@@ -1305,12 +1316,19 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLGetFunctions)(HDBC connection_handle, SQL
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLParamData)(HSTMT StatementHandle, PTR * Value) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, [&](Statement & statement) {
+        return statement.nextDataAtExecParam(Value);
+    });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLPutData)(HSTMT StatementHandle, PTR Data, SQLLEN StrLen_or_Ind) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, [&](Statement & statement) {
+        statement.putData(Data, StrLen_or_Ind);
+        return SQL_SUCCESS;
+    });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLSetCursorName)(HSTMT StatementHandle, SQLTCHAR * CursorName, SQLSMALLINT NameLength) {
@@ -1699,7 +1717,10 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLBulkOperations)(
     SQLSMALLINT      Operation
 ) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+    return impl::BulkOperations(
+        StatementHandle,
+        Operation
+    );
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLCancelHandle)(SQLSMALLINT HandleType, SQLHANDLE Handle) {
@@ -1709,7 +1730,31 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLCancelHandle)(SQLSMALLINT HandleType, SQL
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLCompleteAsync)(SQLSMALLINT HandleType, SQLHANDLE Handle, RETCODE * AsyncRetCodePtr) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    if (HandleType != SQL_HANDLE_STMT)
+        return SQL_ERROR;
+
+    return CALL_WITH_TYPED_HANDLE_ASYNC(SQL_HANDLE_STMT, Handle, [&](Statement & statement) {
+        SQLRETURN rc = SQL_ERROR;
+
+        // Errors of the operation itself go to the diagnostics of the statement, while SQLCompleteAsync succeeds.
+        try {
+            rc = statement.completeAsync();
+        }
+        catch (const SqlException & ex) {
+            statement.fillDiag(ex.getReturnCode(), ex.getSQLState(), ex.what(), 1);
+            rc = ex.getReturnCode();
+        }
+        catch (const std::exception & ex) {
+            statement.fillDiag(SQL_ERROR, "HY000", ex.what(), 1);
+            rc = SQL_ERROR;
+        }
+
+        if (AsyncRetCodePtr)
+            *AsyncRetCodePtr = rc;
+
+        return SQL_SUCCESS;
+    });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLEndTran)(
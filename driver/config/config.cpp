@@ -242,6 +242,9 @@ key_value_map_t readDSNInfo(const std::string & dsn_utf8) {
             INI_HOST,
             INI_PORT,
             INI_TIMEOUT,
+            INI_KEEP_ALIVE_TIMEOUT,
+            INI_RETRY_COUNT,
+            INI_RETRY_BACKOFF,
             INI_VERIFY_CONNECTION_EARLY,
             INI_SSLMODE,
             INI_PRIVATEKEYFILE,
@@ -252,7 +255,16 @@ key_value_map_t readDSNInfo(const std::string & dsn_utf8) {
             INI_STRINGMAXLENGTH,
             INI_DRIVERLOG,
             INI_DRIVERLOGFILE,
-            INI_AUTO_SESSION_ID
+            INI_AUTO_SESSION_ID,
+            INI_COMPRESS_REQUEST,
+            INI_COMPRESS_RESPONSE,
+            INI_PARAMS_IN_BODY,
+            INI_PARALLEL_INSERT_THRESHOLD,
+            INI_PARALLEL_INSERT_STREAMS,
+            INI_BUFFERED_INSERT_MAX_ROWS,
+            INI_BUFFERED_INSERT_MAX_BYTES,
+            INI_BUFFERED_INSERT_FLUSH_INTERVAL,
+            INI_INFER_PARAM_TYPES
         }
     ) {
         if (
@@ -22,6 +22,9 @@ struct ConnInfo {
     std::string server;
     std::string port;
     std::string timeout;
+    std::string keep_alive_timeout;
+    std::string retry_count;
+    std::string retry_backoff;
     std::string verify_connection_early;
     std::string sslmode;
     std::string privateKeyFile;
@@ -33,6 +36,15 @@ struct ConnInfo {
     std::string driverlog;
     std::string driverlogfile;
     std::string auto_session_id;
+    std::string compress_request;
+    std::string compress_response;
+    std::string params_in_body;
+    std::string parallel_insert_threshold;
+    std::string parallel_insert_streams;
+    std::string buffered_insert_max_rows;
+    std::string buffered_insert_max_bytes;
+    std::string buffered_insert_flush_interval;
+    std::string infer_param_types;
 };
 
 key_value_map_t readDSNInfo(const std::string & dsn);
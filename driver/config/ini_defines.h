@@ -20,6 +20,9 @@
 #define INI_HOST            "Host"
 #define INI_PORT            "Port"            /* Port on which the ClickHouse is listening */
 #define INI_TIMEOUT         "Timeout"         /* Connection timeout */
+#define INI_KEEP_ALIVE_TIMEOUT "KeepAliveTimeout" /* Idle time after which a kept-alive connection is not reused */
+#define INI_RETRY_COUNT     "RetryCount"      /* Max number of retries of a failed request */
+#define INI_RETRY_BACKOFF   "RetryBackoff"    /* Base delay before a retry, in milliseconds */
 #define INI_VERIFY_CONNECTION_EARLY "VerifyConnectionEarly"
 #define INI_SSLMODE         "SSLMode"         /* Use 'require' for https connections */
 #define INI_PRIVATEKEYFILE  "PrivateKeyFile"
@@ -32,6 +35,15 @@
 #define INI_DRIVERLOG       "DriverLog"
 #define INI_DRIVERLOGFILE   "DriverLogFile"
 #define INI_AUTO_SESSION_ID "AutoSessionId"
+#define INI_COMPRESS_REQUEST "CompressRequest" /* Compress request bodies: off, gzip, deflate, lz4 */
+#define INI_COMPRESS_RESPONSE "CompressResponse" /* Receive results in ClickHouse native compressed blocks */
+#define INI_PARAMS_IN_BODY  "ParamsInBody"    /* Send query and parameters as multipart/form-data body */
+#define INI_PARALLEL_INSERT_THRESHOLD "ParallelInsertThreshold" /* Min size of an INSERT parameter array to upload it in parallel, 0 to disable */
+#define INI_PARALLEL_INSERT_STREAMS "ParallelInsertStreams" /* Max number of concurrent requests of a parallel upload */
+#define INI_BUFFERED_INSERT_MAX_ROWS "BufferedInsertMaxRows" /* Max number of rows of single INSERT executions buffered into a batch, 0 to disable */
+#define INI_BUFFERED_INSERT_MAX_BYTES "BufferedInsertMaxBytes" /* Max size of a batch of buffered INSERT rows, in bytes */
+#define INI_BUFFERED_INSERT_FLUSH_INTERVAL "BufferedInsertFlushInterval" /* Max time a buffered INSERT row waits for its batch to be sent, in milliseconds */
+#define INI_INFER_PARAM_TYPES "InferParamTypes" /* Infer types of parameters from the columns of the table they are compared with or inserted into */
 
 #if defined(UNICODE)
 #   define INI_DSN_DEFAULT          DSN_DEFAULT_UNICODE
@@ -46,12 +58,24 @@
 #define INI_SERVER_DEFAULT          ""
 #define INI_PORT_DEFAULT            ""
 #define INI_TIMEOUT_DEFAULT         "30"
+#define INI_KEEP_ALIVE_TIMEOUT_DEFAULT "2"
+#define INI_RETRY_COUNT_DEFAULT     "3"
+#define INI_RETRY_BACKOFF_DEFAULT   "100"
 #define INI_VERIFY_CONNECTION_EARLY_DEFAULT "off"
 #define INI_SSLMODE_DEFAULT         ""
 #define INI_DATABASE_DEFAULT        ""
 #define INI_HUGE_INT_AS_STRING_DEFAULT "off"
 #define INI_STRINGMAXLENGTH_DEFAULT "1048575"
 #define INI_AUTO_SESSION_ID_DEFAULT "off"
+#define INI_COMPRESS_REQUEST_DEFAULT "off"
+#define INI_COMPRESS_RESPONSE_DEFAULT "off"
+#define INI_PARAMS_IN_BODY_DEFAULT "off"
+#define INI_PARALLEL_INSERT_THRESHOLD_DEFAULT "0"
+#define INI_PARALLEL_INSERT_STREAMS_DEFAULT "4"
+#define INI_BUFFERED_INSERT_MAX_ROWS_DEFAULT "0"
+#define INI_BUFFERED_INSERT_MAX_BYTES_DEFAULT "10485760"
+#define INI_BUFFERED_INSERT_FLUSH_INTERVAL_DEFAULT "200"
+#define INI_INFER_PARAM_TYPES_DEFAULT "off"
 
 #ifdef NDEBUG
 #    define INI_DRIVERLOG_DEFAULT "off"
@@ -8,7 +8,10 @@
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/NumberParser.h> // TODO: switch to std
 #include <Poco/URI.h>
+
+#include <algorithm>
 #include <random>
+#include <utility>
 
 #if !defined(WORKAROUND_DISABLE_SSL)
 #    include <Poco/Net/AcceptCertificateHandler.h>
@@ -48,6 +51,45 @@ void SSLInit(bool ssl_strict, const std::string & privateKeyFile, const std::str
 }
 #endif
 
+namespace {
+
+// Collects the names and the types of the columns from the result of DESCRIBE TABLE.
+class DescribeTableResultMutator
+    : public ResultMutator
+{
+public:
+    explicit DescribeTableResultMutator(Connection::TableColumnTypes & column_types_)
+        : column_types(column_types_)
+    {
+    }
+
+    void transformRow(const std::vector<ColumnInfo> & /*unused*/, Row & row) override {
+        const auto get_string = [] (const Field & field) -> const std::string * {
+            if (const auto * value = std::get_if<DataSourceType<DataSourceTypeId::String>>(&field.data))
+                return &value->value;
+
+            if (const auto * value = std::get_if<WireTypeAnyAsString>(&field.data))
+                return &value->value;
+
+            return nullptr;
+        };
+
+        if (row.fields.size() < 2)
+            return;
+
+        const auto * name = get_string(row.fields[0]);
+        const auto * type = get_string(row.fields[1]);
+
+        if (name && type)
+            column_types.emplace(*name, *type);
+    }
+
+private:
+    Connection::TableColumnTypes & column_types;
+};
+
+} // namespace
+
 std::string GenerateSessionId() {
     std::mt19937 generator(std::random_device{}());
     std::uniform_int_distribution<std::uint64_t> distribution(0);
@@ -61,6 +103,38 @@ Connection::Connection(Environment & environment)
     resetConfiguration();
 }
 
+Connection::~Connection() {
+    stopInsertFlusher();
+
+    // The application hasn't flushed the batches, so their rows are sent on a best effort basis, with nobody to report the failure to.
+    if (insert_statement && !insert_batches.empty()) {
+        try {
+            sendInsertBatches(false);
+        }
+        catch (...) {
+        }
+
+        if (insert_batch_failure) {
+            try {
+                std::rethrow_exception(insert_batch_failure);
+            }
+            catch (const std::exception & ex) {
+                LOG("Dropping buffered rows: " << ex.what());
+            }
+            catch (...) {
+            }
+        }
+    }
+
+    std::size_t row_count = 0;
+    for (const auto & [path_and_query, batch] : insert_batches) {
+        row_count += batch.row_count;
+    }
+
+    if (row_count > 0)
+        LOG("Dropping " << row_count << " buffered rows that have not been sent");
+}
+
 const TypeInfo & Connection::getTypeInfo(const std::string & type_name, const std::string & type_name_without_parameters) const {
     auto tmp_type_name = type_name;
     auto tmp_type_name_without_parameters = type_name_without_parameters;
@@ -75,6 +149,17 @@ const TypeInfo & Connection::getTypeInfo(const std::string & type_name, const st
     return getParent().getTypeInfo(tmp_type_name, tmp_type_name_without_parameters);
 }
 
+Connection::RequestSettings Connection::getRequestSettings() const {
+    RequestSettings settings;
+    settings.request_template = request_template;
+    settings.retry_policy = getRetryPolicy();
+    settings.redirect_limit = redirect_limit;
+    settings.compress_request = compress_request;
+    settings.connection_timeout = connection_timeout;
+    settings.timeout = timeout;
+    return settings;
+}
+
 Poco::URI Connection::getUri() const {
     Poco::URI uri(url);
 
@@ -118,9 +203,23 @@ Poco::URI Connection::getUri() const {
         uri.addQueryParameter("session_id", session_id);
     }
 
+    if (compress_response)
+        uri.addQueryParameter("compress", "1");
+
     return uri;
 }
 
+void Connection::updateRequestTemplate() {
+    const auto uri = getUri();
+
+    request_template.path_and_query = uri.getPathAndQuery();
+    request_template.credentials = buildCredentialsString();
+    request_template.user_agent = buildUserAgentString();
+
+    // Unqualified table names may refer to the tables of another database now.
+    table_column_types.clear();
+}
+
 void Connection::connect(const std::string & connection_string) {
     if (session && session->connected())
         throw SqlException("Connection name in use", "08002");
@@ -199,7 +298,9 @@ void Connection::connect(const std::string & connection_string) {
     session->setPort(port);
     session->setKeepAlive(true);
     session->setTimeout(Poco::Timespan(connection_timeout, 0), Poco::Timespan(timeout, 0), Poco::Timespan(timeout, 0));
-    session->setKeepAliveTimeout(Poco::Timespan(86400, 0));
+    session->setKeepAliveTimeout(Poco::Timespan(keep_alive_timeout, 0));
+
+    updateRequestTemplate();
 
     if (verify_connection_early) {
         verifyConnection();
@@ -216,6 +317,9 @@ void Connection::resetConfiguration() {
     port = 0;
     connection_timeout = 0;
     timeout = 0;
+    keep_alive_timeout = 0;
+    retry_count = 3;
+    retry_backoff = 0;
     sslmode.clear();
     privateKeyFile.clear();
     certificateFile.clear();
@@ -224,6 +328,15 @@ void Connection::resetConfiguration() {
     default_format.clear();
     database.clear();
     stringmaxlength = 0;
+    compress_request = CompressionMethod::None;
+    compress_response = false;
+    params_in_body = false;
+    parallel_insert_threshold = 0;
+    parallel_insert_streams = 0;
+    buffered_insert_max_rows = 0;
+    buffered_insert_max_bytes = 0;
+    buffered_insert_flush_interval = 0;
+    infer_param_types = false;
 }
 
 void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_value_map_t & dsn_fields) {
@@ -282,7 +395,8 @@ void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_v
             Poco::UTF8::icompare(key, INI_HOST) == 0
         ) {
             recognized_key = true;
-            valid_value = true;
+            std::vector<HostPool::Endpoint> endpoints;
+            valid_value = (value.empty() || tryParseHostList(value, 1, endpoints));
             if (valid_value) {
                 server = value;
             }
@@ -310,6 +424,39 @@ void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_v
                 timeout = typed_value;
             }
         }
+        else if (Poco::UTF8::icompare(key, INI_KEEP_ALIVE_TIMEOUT) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value <= std::numeric_limits<decltype(keep_alive_timeout)>::max()
+            ));
+            if (valid_value) {
+                keep_alive_timeout = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_RETRY_COUNT) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value <= 100
+            ));
+            if (valid_value && !value.empty()) {
+                retry_count = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_RETRY_BACKOFF) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value <= std::numeric_limits<decltype(retry_backoff)>::max()
+            ));
+            if (valid_value) {
+                retry_backoff = typed_value;
+            }
+        }
         else if (Poco::UTF8::icompare(key, INI_VERIFY_CONNECTION_EARLY) == 0) {
             recognized_key = true;
             valid_value = (value.empty() || isYesOrNo(value));
@@ -404,6 +551,93 @@ void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_v
                 auto_session_id = isYes(value);
             }
         }
+        else if (Poco::UTF8::icompare(key, INI_COMPRESS_REQUEST) == 0) {
+            recognized_key = true;
+            CompressionMethod typed_value = CompressionMethod::None;
+            valid_value = tryParseCompressionMethod(value, typed_value);
+            if (valid_value) {
+                compress_request = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_COMPRESS_RESPONSE) == 0) {
+            recognized_key = true;
+            valid_value = (value.empty() || isYesOrNo(value));
+            if (valid_value) {
+                compress_response = isYes(value);
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_PARAMS_IN_BODY) == 0) {
+            recognized_key = true;
+            valid_value = (value.empty() || isYesOrNo(value));
+            if (valid_value) {
+                params_in_body = isYes(value);
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_PARALLEL_INSERT_THRESHOLD) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value <= std::numeric_limits<decltype(parallel_insert_threshold)>::max()
+            ));
+            if (valid_value) {
+                parallel_insert_threshold = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_PARALLEL_INSERT_STREAMS) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value > 0 &&
+                typed_value <= 64
+            ));
+            if (valid_value) {
+                parallel_insert_streams = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_BUFFERED_INSERT_MAX_ROWS) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value <= std::numeric_limits<decltype(buffered_insert_max_rows)>::max()
+            ));
+            if (valid_value) {
+                buffered_insert_max_rows = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_BUFFERED_INSERT_MAX_BYTES) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value > 0 &&
+                typed_value <= std::numeric_limits<decltype(buffered_insert_max_bytes)>::max()
+            ));
+            if (valid_value) {
+                buffered_insert_max_bytes = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_BUFFERED_INSERT_FLUSH_INTERVAL) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value > 0 &&
+                typed_value <= std::numeric_limits<decltype(buffered_insert_flush_interval)>::max()
+            ));
+            if (valid_value) {
+                buffered_insert_flush_interval = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_INFER_PARAM_TYPES) == 0) {
+            recognized_key = true;
+            valid_value = (value.empty() || isYesOrNo(value));
+            if (valid_value) {
+                infer_param_types = isYes(value);
+            }
+        }
 
         return std::make_tuple(recognized_key, valid_value);
     };
@@ -516,12 +750,38 @@ void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_v
     if (port == 0)
         port = (Poco::UTF8::icompare(proto, "https") == 0 ? 8443 : 8123);
 
+    // Server may be a comma-separated list of replicas, each with an optional port. The first one is reported as the server.
+    {
+        std::vector<HostPool::Endpoint> endpoints;
+        if (!tryParseHostList(server, port, endpoints))
+            throw std::runtime_error("Bad value '" + server + "' for attribute '" INI_SERVER "'");
+
+        server = endpoints.front().host;
+        port = endpoints.front().port;
+        hosts.reset(std::move(endpoints));
+    }
+
     if (timeout == 0)
         timeout = 30;
 
     if (connection_timeout == 0)
         connection_timeout = timeout;
 
+    if (keep_alive_timeout == 0)
+        keep_alive_timeout = 2;
+
+    if (retry_backoff == 0)
+        retry_backoff = 100;
+
+    if (parallel_insert_streams == 0)
+        parallel_insert_streams = 4;
+
+    if (buffered_insert_max_bytes == 0)
+        buffered_insert_max_bytes = 10 * 1024 * 1024;
+
+    if (buffered_insert_flush_interval == 0)
+        buffered_insert_flush_interval = 200;
+
     if (path.empty())
         path = "query";
 
@@ -553,6 +813,181 @@ void Connection::verifyConnection() {
     statement.deallocateSelf();
 }
 
+void Connection::bufferInsert(const std::string & path_and_query, const std::string & rows, std::size_t row_count) {
+    if (!insert_statement)
+        insert_statement = &allocateChild<Statement>();
+
+    bool is_full = false;
+
+    {
+        std::lock_guard<std::mutex> lock(insert_batches_mutex);
+
+        if (insert_batch_failure)
+            std::rethrow_exception(std::exchange(insert_batch_failure, nullptr));
+
+        if (!insert_flusher.joinable()) {
+            stop_insert_flusher = false;
+            insert_flusher = std::thread([this] () { runInsertFlusher(); });
+        }
+
+        auto & batch = insert_batches[path_and_query];
+        if (batch.row_count == 0) {
+            batch.settings = getRequestSettings();
+            batch.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(buffered_insert_flush_interval);
+            insert_flusher_cv.notify_one();
+        }
+
+        batch.body += rows;
+        batch.row_count += row_count;
+
+        if (batch.row_count >= buffered_insert_max_rows || batch.body.size() >= buffered_insert_max_bytes) {
+            batch.deadline = std::chrono::steady_clock::time_point::min();
+            is_full = true;
+        }
+    }
+
+    // The batch is sent by the thread whose rows filled it, so that the pace of the application is limited by that of the server.
+    if (is_full) {
+        sendInsertBatches(true);
+        rethrowInsertBatchFailure();
+    }
+}
+
+void Connection::flushInsertBatches() {
+    if (!insert_statement)
+        return;
+
+    sendInsertBatches(false);
+    rethrowInsertBatchFailure();
+}
+
+std::shared_ptr<const Connection::TableColumnTypes> Connection::getTableColumnTypes(const std::string & table) {
+    std::shared_ptr<const TableColumnTypes> cached;
+    if (table_column_types.tryGet(table, cached))
+        return cached;
+
+    auto column_types = std::make_shared<TableColumnTypes>();
+    auto & statement = allocateChild<Statement>();
+
+    try {
+        statement.executeQuery("DESCRIBE TABLE " + table, std::make_unique<DescribeTableResultMutator>(*column_types));
+
+        // The rows are passed to the mutator as they are read.
+        while (statement.hasResultSet() && statement.getResultSet().fetchRowSet(SQL_FETCH_NEXT, 0, 100) > 0) {
+        }
+    }
+    catch (const std::exception & ex) {
+        // The types are used only if known, so this is not an error of the query the parameters are in. The failure is cached too,
+        // so that a table that can't be described (e.g., a table function, or a missing grant) isn't described again for every query.
+        LOG("Failed to describe table " << table << ": " << ex.what());
+        statement.deallocateSelf();
+        column_types->clear();
+        table_column_types.put(table, column_types);
+        return column_types;
+    }
+
+    statement.deallocateSelf();
+
+    LOG("Described table " << table << ": " << column_types->size() << " columns");
+    table_column_types.put(table, column_types);
+    return column_types;
+}
+
+void Connection::sendInsertBatches(bool due_only) {
+    std::lock_guard<std::mutex> send_lock(insert_send_mutex);
+
+    std::vector<std::pair<std::string, InsertBatch>> batches;
+
+    {
+        std::lock_guard<std::mutex> lock(insert_batches_mutex);
+        const auto now = std::chrono::steady_clock::now();
+
+        for (auto it = insert_batches.begin(); it != insert_batches.end();) {
+            if (!due_only || it->second.deadline <= now) {
+                batches.emplace_back(it->first, std::move(it->second));
+                it = insert_batches.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    std::sort(batches.begin(), batches.end(), [] (const auto & left, const auto & right) {
+        return (left.second.deadline < right.second.deadline);
+    });
+
+    for (const auto & [path_and_query, batch] : batches) {
+        std::string sql_state = "HY000";
+        std::string message;
+
+        try {
+            LOG("Sending a batch of " << batch.row_count << " buffered rows (" << batch.body.size() << " bytes)");
+            insert_statement->sendInsertBatch(path_and_query, batch.body, batch.settings);
+            continue;
+        }
+        catch (const SqlException & ex) {
+            sql_state = ex.getSQLState();
+            message = ex.what();
+        }
+        catch (const Poco::Exception & ex) {
+            message = ex.displayText();
+        }
+        catch (const std::exception & ex) {
+            message = ex.what();
+        }
+
+        LOG("Failed to insert a batch of " << batch.row_count << " buffered rows: " << message);
+
+        // The rows of a batch are inserted all, or none of them, and none of the executions that buffered them can report it anymore.
+        std::lock_guard<std::mutex> lock(insert_batches_mutex);
+        if (!insert_batch_failure)
+            insert_batch_failure = std::make_exception_ptr(SqlException("Failed to insert a batch of " + std::to_string(batch.row_count) + " buffered rows: " + message, sql_state));
+    }
+}
+
+void Connection::rethrowInsertBatchFailure() {
+    std::lock_guard<std::mutex> lock(insert_batches_mutex);
+
+    if (insert_batch_failure)
+        std::rethrow_exception(std::exchange(insert_batch_failure, nullptr));
+}
+
+void Connection::runInsertFlusher() {
+    std::unique_lock<std::mutex> lock(insert_batches_mutex);
+
+    while (!stop_insert_flusher) {
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        for (const auto & [path_and_query, batch] : insert_batches) {
+            deadline = std::min(deadline, batch.deadline);
+        }
+
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            insert_flusher_cv.wait(lock);
+        }
+        else if (std::chrono::steady_clock::now() < deadline) {
+            insert_flusher_cv.wait_until(lock, deadline);
+        }
+        else {
+            lock.unlock();
+            sendInsertBatches(true);
+            lock.lock();
+        }
+    }
+}
+
+void Connection::stopInsertFlusher() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(insert_batches_mutex);
+        stop_insert_flusher = true;
+    }
+
+    insert_flusher_cv.notify_one();
+
+    if (insert_flusher.joinable())
+        insert_flusher.join();
+}
+
 std::string Connection::buildCredentialsString() const {
     std::ostringstream user_password_base64;
     Poco::Base64Encoder base64_encoder(user_password_base64);
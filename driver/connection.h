@@ -3,12 +3,21 @@
 #include "driver/driver.h"
 #include "driver/environment.h"
 #include "driver/config/config.h"
+#include "driver/utils/compression.h"
+#include "driver/utils/host_pool.h"
+#include "driver/utils/lru_cache.h"
+#include "driver/utils/retry_policy.h"
 
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/URI.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 class DescriptorRecord;
 class Descriptor;
@@ -31,6 +40,9 @@ public: // Configuration fields.
     std::uint16_t port = 0;
     std::uint32_t connection_timeout = 0;
     std::uint32_t timeout = 0;
+    std::uint32_t keep_alive_timeout = 0;
+    int retry_count = 3;
+    std::uint32_t retry_backoff = 0;
     bool verify_connection_early = false;
     std::string sslmode;
     std::string privateKeyFile;
@@ -42,16 +54,57 @@ public: // Configuration fields.
     bool huge_int_as_string = false;
     std::int32_t stringmaxlength = 0;
     bool auto_session_id = false;
+    CompressionMethod compress_request = CompressionMethod::None;
+    bool compress_response = false;
+    bool params_in_body = false;
+    std::uint32_t parallel_insert_threshold = 0;
+    std::uint32_t parallel_insert_streams = 0;
+    std::uint32_t buffered_insert_max_rows = 0;
+    std::uint32_t buffered_insert_max_bytes = 0;
+    std::uint32_t buffered_insert_flush_interval = 0;
+    bool infer_param_types = false;
 
 public:
     std::string useragent;
 
     std::unique_ptr<Poco::Net::HTTPClientSession> session;
-    int retry_count = 3;
+    HostPool hosts; // All the replicas listed in the server attribute, the first one is also in server/port.
     int redirect_limit = 10;
 
+    // Queries longer than this are not cached, so that the cache stays small.
+    static constexpr std::size_t max_cached_query_size = 64 * 1024;
+
+    // Recently prepared query templates, keyed by SQL_ATTR_NOSCAN flag ('0' or '1') followed by the query text as passed by the application.
+    LRUCache<std::string, std::shared_ptr<const PreparedQueryTemplate>> prepared_queries{256};
+
+    // Types of the columns of a table, by column name.
+    using TableColumnTypes = std::unordered_map<std::string, std::string>;
+
+    // Types of the columns of recently described tables (see InferParamTypes), keyed by the table name as written in queries.
+    // Tables that failed to be described have no columns. Cleared when the request template (e.g., the database) changes.
+    LRUCache<std::string, std::shared_ptr<const TableColumnTypes>> table_column_types{64};
+
+    // Parts of HTTP requests that are the same for all queries sent over this connection, regardless of the replica.
+    struct RequestTemplate {
+        std::string path_and_query; // Encoded path and fixed query string, per-query parameters are appended to it.
+        std::string credentials;    // Base64 encoded "user:password".
+        std::string user_agent;
+    };
+
+    // Everything a request is built and sent with, copied by the operations that send requests in the background,
+    // so that they are not affected by the application changing the connection attributes in the meantime.
+    struct RequestSettings {
+        RequestTemplate request_template;
+        RetryPolicy retry_policy;
+        int redirect_limit = 10;
+        CompressionMethod compress_request = CompressionMethod::None;
+        std::uint32_t connection_timeout = 0;
+        std::uint32_t timeout = 0;
+    };
+
 public:
     explicit Connection(Environment & environment);
+    virtual ~Connection();
 
     // Lookup TypeInfo for given name of type.
     const TypeInfo & getTypeInfo(const std::string & type_name, const std::string & type_name_without_parameters) const;
@@ -65,14 +118,46 @@ public:
     const std::string& getServer() const { return server; }
     int getPort() const { return port; }
 
+    RetryPolicy getRetryPolicy() const {
+        RetryPolicy policy;
+        policy.max_retries = retry_count;
+        policy.base_backoff = std::chrono::milliseconds(retry_backoff);
+        return policy;
+    }
+
+    // Get a copy of the current request settings.
+    RequestSettings getRequestSettings() const;
+
     void connect(const std::string & connection_string);
 
+    // Append serialized rows of an execution of the INSERT in path_and_query to the batch of the same INSERT (see BufferedInsertMaxRows),
+    // and send the batch, if it is full. Otherwise, the batch is sent in background, once it is BufferedInsertFlushInterval old.
+    // Rethrows the failure to insert any batch sent since the last report, in which case the rows are not buffered.
+    void bufferInsert(const std::string & path_and_query, const std::string & rows, std::size_t row_count);
+
+    // Send all the buffered batches, and wait until they are inserted. Rethrows the failure to insert any batch sent since the last report.
+    // Batches are not sent when the statements that buffered them are closed, so that repeated executions can share a batch.
+    void flushInsertBatches();
+
+    // Stop the background thread that sends the batches when they are due. It is started again by the next bufferInsert().
+    void stopInsertFlusher() noexcept;
+
+    // Get the types of the columns of a table, fetching them with DESCRIBE TABLE, if not cached yet.
+    // A table that can't be described has no known columns. Must be called on the application's thread, since it allocates a statement.
+    std::shared_ptr<const TableColumnTypes> getTableColumnTypes(const std::string & table);
+
     // Return a Base64 encoded string of "user:password".
     std::string buildCredentialsString() const;
 
     // Return a crafted User-Agent string.
     std::string buildUserAgentString() const;
 
+    // Return the request template, built in connect() from the configuration.
+    const RequestTemplate & getRequestTemplate() const { return request_template; }
+
+    // Rebuild the request template. Must be called whenever any of the fields it depends on changes.
+    void updateRequestTemplate();
+
     // Reset the descriptor and initialize it with default attributes.
     void initAsAD(Descriptor & desc, bool user = false); // as Application Descriptor
     void initAsID(Descriptor & desc); // as Implementation Descriptor
@@ -104,9 +189,34 @@ private:
     // Verify the connection and credentials by trying to remotely execute a simple "SELECT 1" query.
     void verifyConnection();
 
+    // Rows buffered by bufferInsert(), to be inserted by a single request.
+    struct InsertBatch {
+        std::string body;
+        std::size_t row_count = 0;
+        std::chrono::steady_clock::time_point deadline;
+        RequestSettings settings; // As of when the first rows were buffered.
+    };
+
+    // Send the batches that are due, or all of them, one by one. The failure to insert a batch is kept until it is reported.
+    void sendInsertBatches(bool due_only);
+    void rethrowInsertBatchFailure();
+
+    // Background thread that sends the batches when they are due.
+    void runInsertFlusher();
+
 private:
+    RequestTemplate request_template;
     std::unordered_map<SQLHANDLE, std::shared_ptr<Descriptor>> descriptors;
     std::unordered_map<SQLHANDLE, std::shared_ptr<Statement>> statements;
+
+    Statement * insert_statement = nullptr; // Internal statement that sends the batches, allocated when the first rows are buffered.
+    std::map<std::string, InsertBatch> insert_batches; // By path and query string of the INSERT.
+    std::exception_ptr insert_batch_failure; // The first one that hasn't been reported yet.
+    bool stop_insert_flusher = false;
+    std::mutex insert_batches_mutex; // Guards the above.
+    std::mutex insert_send_mutex; // Batches are sent one at a time, in the order they became due.
+    std::condition_variable insert_flusher_cv;
+    std::thread insert_flusher;
 };
 
 template <> Descriptor& Connection::allocateChild<Descriptor>();
@@ -50,6 +50,7 @@
 #define CALL_WITH_HANDLE_SKIP_DIAG(handle, callable)                    (Driver::getInstance().call(callable, handle, 0, true))
 #define CALL_WITH_TYPED_HANDLE(handle_type, handle, callable)           (Driver::getInstance().call(callable, handle, handle_type))
 #define CALL_WITH_TYPED_HANDLE_SKIP_DIAG(handle_type, handle, callable) (Driver::getInstance().call(callable, handle, handle_type, true))
+#define CALL_WITH_TYPED_HANDLE_ASYNC(handle_type, handle, callable)     (Driver::getInstance().call(callable, handle, handle_type, false, true))
 
 class Environment;
 class Connection;
@@ -169,8 +170,10 @@ private:
     }
 
 public:
+    // While an asynchronous operation is in progress on a statement, calls on its handle fail with HY010, unless they skip diagnostics
+    // (SQLGetDiag*, SQLFreeHandle), or allow_async is set (polls of the operation, SQLCancel, SQLCompleteAsync).
     template <typename Callable>
-    inline SQLRETURN call(Callable && callable, SQLHANDLE handle = nullptr, SQLSMALLINT handle_type = 0, bool skip_diag = false) const noexcept;
+    inline SQLRETURN call(Callable && callable, SQLHANDLE handle = nullptr, SQLSMALLINT handle_type = 0, bool skip_diag = false, bool allow_async = false) const noexcept;
 
 private:
     std::string log_file_name;
@@ -202,7 +205,7 @@ void Driver::unregisterDescendant(T & descendant) noexcept {
 }
 
 template <typename Callable>
-inline SQLRETURN Driver::call(Callable && callable, SQLHANDLE handle, SQLSMALLINT handle_type, bool skip_diag) const noexcept {
+inline SQLRETURN Driver::call(Callable && callable, SQLHANDLE handle, SQLSMALLINT handle_type, bool skip_diag, bool allow_async) const noexcept {
     try {
         if (handle == nullptr) {
             if (handle_type == 0) {
@@ -232,6 +235,13 @@ inline SQLRETURN Driver::call(Callable && callable, SQLHANDLE handle, SQLSMALLIN
                 auto & descendant = descendant_ref.get();
 
                 try {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(descendant)>, Statement>) {
+                        if (!skip_diag && !allow_async && descendant.isAsyncInProgress()) {
+                            descendant.resetDiag();
+                            throw SqlException("Function sequence error", "HY010");
+                        }
+                    }
+
                     return doCall(callable, descendant, skip_diag);
                 }
                 catch (const SqlException & ex) {
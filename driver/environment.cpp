@@ -1,6 +1,7 @@
 #include "driver/environment.h"
 #include "driver/connection.h"
 
+#include <exception>
 #include <string>
 
 Environment::Environment(Driver & driver)
@@ -37,6 +38,23 @@ const TypeInfo & Environment::getTypeInfo(const std::string & type_name, const s
     throw SqlException("Invalid SQL data type", "HY004");
 }
 
+void Environment::flushInsertBatches() {
+    std::exception_ptr first_failure;
+
+    for (auto & [handle, connection] : connections) {
+        try {
+            connection->flushInsertBatches();
+        }
+        catch (...) {
+            if (!first_failure)
+                first_failure = std::current_exception();
+        }
+    }
+
+    if (first_failure)
+        std::rethrow_exception(first_failure);
+}
+
 template <>
 Connection& Environment::allocateChild<Connection>() {
     auto child_sptr = std::make_shared<Connection>(*this);
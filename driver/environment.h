@@ -22,6 +22,9 @@ public:
 
     const TypeInfo & getTypeInfo(const std::string & type_name, const std::string & type_name_without_parameters) const;
 
+    // Send the buffered INSERT rows of all the connections. Rethrows the first failure, after trying all of them.
+    void flushInsertBatches();
+
 public:
 #if defined(SQL_OV_ODBC3_80)
     int odbc_version = SQL_OV_ODBC3_80;
@@ -7,7 +7,10 @@
 */
 #include "driver/escaping/escape_sequences.h"
 #include "driver/escaping/lexer.h"
+#include "driver/exception.h"
 
+#include <cctype>
+#include <cstring>
 #include <iostream>
 #include <map>
 
@@ -412,45 +415,189 @@ string processEscapeSequences(const StringView seq) {
     return processEscapeSequencesImpl(seq, lex);
 }
 
-} // namespace
+// Position right after the quoted string literal or identifier that starts at p. Backslash escapes the next char,
+// doubled quote char stands for itself. Unterminated ones span till the end of the text.
+const char * skipQuoted(const char * p, const char * end) {
+    const char quote = *p;
 
-std::string replaceEscapeSequences(const std::string & query) {
-    const char * p = query.c_str();
-    const char * end = p + query.size();
-    const char * st = p;
+    for (++p; p < end; ++p) {
+        if (*p == '\\') {
+            if (p + 1 < end)
+                ++p;
+        }
+        else if (*p == quote) {
+            if (p + 1 < end && p[1] == quote)
+                ++p;
+            else
+                return p + 1;
+        }
+    }
+
+    return end;
+}
+
+// Position right after the comment that starts at p, or p itself, if there is no comment there.
+const char * skipComment(const char * p, const char * end) {
+    if (p + 1 < end && p[0] == '-' && p[1] == '-') {
+        const auto * eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        return (eol ? eol + 1 : end);
+    }
+
+    if (p + 1 < end && p[0] == '/' && p[1] == '*') {
+        for (p += 2; p + 1 < end; ++p) {
+            if (p[0] == '*' && p[1] == '/')
+                return p + 2;
+        }
+        return end;
+    }
+
+    return p;
+}
+
+// Position of the '}' that closes the '{' at p, or nullptr, if there is none.
+const char * findClosingCurly(const char * p, const char * end) {
     int level = 0;
-    std::string ret;
 
-    while (p != end) {
+    while (p < end) {
         switch (*p) {
+            case '\'':
+            case '"':
+            case '`':
+                p = skipQuoted(p, end);
+                continue;
+
             case '{':
-                if (level == 0) {
-                    if (st < p) {
-                        ret += std::string(st, p);
-                    }
-                    st = p;
-                }
-                level++;
+                ++level;
                 break;
 
             case '}':
-                if (level == 0) {
-                    // TODO unexpected '}'
-                    return query;
+                if (--level == 0)
+                    return p;
+                break;
+        }
+
+        ++p;
+    }
+
+    return nullptr;
+}
+
+bool isParamNameChar(char ch, bool first) {
+    return (ch == '_' || std::isalpha(static_cast<unsigned char>(ch)) || (!first && std::isdigit(static_cast<unsigned char>(ch))));
+}
+
+// Append [begin, end) to out, with escape sequences replaced, if requested, and collect the parameter markers (with their
+// positions in out) into params, if it is not null. Everything is done in one pass, and the text is copied in chunks between
+// the escape sequences. String literals, quoted identifiers and comments are skipped as a whole.
+void scanQuery(const char * begin, const char * end, bool replace_escape_sequences, std::string & out, std::vector<ParamInfo> * params) {
+    const char * copied = begin; // [copied, p) is yet to be appended to out.
+    const char * p = begin;
+
+    while (p < end) {
+        switch (*p) {
+            case '\\': {
+                p += (p + 1 < end ? 2 : 1); // Skip the next char unconditionally.
+                continue;
+            }
+
+            case '\'':
+            case '"':
+            case '`': {
+                p = skipQuoted(p, end);
+                continue;
+            }
+
+            case '-':
+            case '/': {
+                const auto * comment_end = skipComment(p, end);
+                if (comment_end != p) {
+                    p = comment_end;
+                    continue;
                 }
-                if (--level == 0) {
-                    ret += processEscapeSequences(StringView(st, p + 1));
-                    st = p + 1;
+                break;
+            }
+
+            case '?': {
+                if (params) {
+                    ParamInfo param_info;
+                    param_info.marker_pos = out.size() + (p - copied);
+                    param_info.marker_size = 1;
+                    params->emplace_back(std::move(param_info));
                 }
                 break;
+            }
+
+            case '@': {
+                if (params) {
+                    const char * name_end = p + 1;
+                    while (name_end < end && isParamNameChar(*name_end, name_end == p + 1))
+                        ++name_end;
+
+                    if (name_end == p + 1)
+                        throw SqlException("Syntax error or access violation", "42000");
+
+                    ParamInfo param_info;
+                    param_info.name.assign(p, name_end);
+                    param_info.marker_pos = out.size() + (p - copied);
+                    param_info.marker_size = name_end - p;
+                    params->emplace_back(std::move(param_info));
+
+                    p = name_end;
+                    continue;
+                }
+                break;
+            }
+
+            case '{': {
+                if (!replace_escape_sequences)
+                    break;
+
+                const auto * close = findClosingCurly(p, end);
+                if (!close)
+                    break;
+
+                // Anything that is not a recognized escape sequence, e.g., a map literal, is returned as is, and scanned as a regular text.
+                const StringView seq(p, close + 1);
+                const auto replacement = processEscapeSequences(seq);
+                if (replacement.size() == seq.size() && replacement.compare(0, replacement.size(), seq.data(), seq.size()) == 0)
+                    break;
+
+                out.append(copied, p);
+                scanQuery(replacement.data(), replacement.data() + replacement.size(), false, out, params);
+                p = close + 1;
+                copied = p;
+                continue;
+            }
         }
 
         ++p;
     }
 
-    if (st < p) {
-        ret += std::string(st, p);
+    out.append(copied, end);
+}
+
+} // namespace
+
+std::string replaceEscapeSequences(const std::string & query) {
+    if (query.find('{') == std::string::npos)
+        return query;
+
+    std::string result;
+    result.reserve(query.size());
+    scanQuery(query.data(), query.data() + query.size(), true, result, nullptr);
+    return result;
+}
+
+PreparedQueryTemplate prepareQueryTemplate(const std::string & query, bool replace_escape_sequences) {
+    PreparedQueryTemplate result;
+
+    // Most of the queries have neither escape sequences nor parameters.
+    if (query.find_first_of(replace_escape_sequences ? "{?@" : "?@") == std::string::npos) {
+        result.query = query;
+        return result;
     }
 
-    return ret;
+    result.query.reserve(query.size());
+    scanQuery(query.data(), query.data() + query.size(), replace_escape_sequences, result.query, &result.parameters);
+    return result;
 }
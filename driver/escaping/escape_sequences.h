@@ -1,9 +1,16 @@
 #pragma once
 
+#include "driver/utils/type_info.h"
+
 #include <string>
 
 /** Replaces ODBC escape-sequence into a ClickHouse SQL-dialect.
  *
- * In case of error, input is returned as-is, with no modifications.
+ * Escape sequences that can't be processed are left as-is, with no modifications.
  */
 std::string replaceEscapeSequences(const std::string & query);
+
+/** Prepares the query for execution in a single pass: replaces ODBC escape-sequences, if requested, and finds
+ *  '?' and '@name' parameter markers outside of string literals, quoted identifiers and comments.
+ */
+PreparedQueryTemplate prepareQueryTemplate(const std::string & query, bool replace_escape_sequences);
@@ -1,6 +1,9 @@
 #include "driver/escaping/lexer.h"
 
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <string_view>
 #include <unordered_map>
 
 #include <cctype>
@@ -14,7 +17,16 @@ namespace {
 #define DECLARE_SQL_TSI(NAME) \
     { #NAME, Token::SQL_TSI_##NAME }
 
-static const std::unordered_map<std::string, Token::Type> KEYWORDS = {
+// Allows looking the keywords up by std::string_view, without constructing a std::string.
+struct KeywordHash {
+    using is_transparent = void;
+
+    std::size_t operator() (std::string_view str) const {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+static const std::unordered_map<std::string, Token::Type, KeywordHash, std::equal_to<>> KEYWORDS = {
     DECLARE(FN),
     DECLARE(D),
     DECLARE(T),
@@ -38,20 +50,32 @@ static const std::unordered_map<std::string, Token::Type> KEYWORDS = {
 #undef DECLARE2
 #undef DECLARE_SQL_TSI
 
-static Token::Type LookupIdent(const std::string & ident) {
-    auto ki = KEYWORDS.find(ident);
+static const std::size_t MAX_KEYWORD_SIZE = [] {
+    std::size_t max_size = 0;
+    for (const auto & keyword : KEYWORDS) {
+        max_size = std::max(max_size, keyword.first.size());
+    }
+    return max_size;
+}();
+
+static Token::Type LookupIdent(const StringView & ident) {
+    // Keywords are matched case-insensitively, the identifier is upper-cased into a local buffer, to avoid allocating a string for each of them.
+    std::array<char, 64> upper;
+    if (ident.size() > MAX_KEYWORD_SIZE || ident.size() > upper.size()) {
+        return Token::IDENT;
+    }
+
+    std::transform(ident.data(), ident.data() + ident.size(), upper.begin(), [] (char ch) {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    });
+
+    auto ki = KEYWORDS.find(std::string_view(upper.data(), ident.size()));
     if (ki != KEYWORDS.end()) {
         return ki->second;
     }
     return Token::IDENT;
 }
 
-std::string to_upper(const StringView & str) {
-    std::string ret(str.data(), str.size());
-    std::transform(ret.begin(), ret.end(), ret.begin(), ::toupper);
-    return ret;
-}
-
 } // namespace
 
 Lexer::Lexer(const StringView text) : text_(text), cur_(text.data()), end_(text.data() + text.size()), emit_space_(false) {}
@@ -217,7 +241,7 @@ Token Lexer::NextToken() {
                         return Token {Token::IDENT, StringView(st, cur_)};
                     }
                     else {
-                        return Token {LookupIdent(to_upper(StringView(st, cur_))), StringView(st, cur_)};
+                        return Token {LookupIdent(StringView(st, cur_)), StringView(st, cur_)};
                     }
                 }
 
@@ -180,34 +180,34 @@ void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTyp
     dest.precision = column_info.precision;
     dest.scale = column_info.scale;
 
+    // Negating in the unsigned domain avoids overflow for the minimum values.
+
     if (dest.precision < 10) {
         std::int32_t value = 0;
         readPOD(value);
 
-        if (value < 0) {
-            dest.sign = 0;
-            dest.value = -value;
-        }
-        else {
-            dest.sign = 1;
-            dest.value = value;
-        }
+        dest.sign = (value < 0 ? 0 : 1);
+        dest.value = (value < 0 ? -static_cast<std::uint32_t>(value) : static_cast<std::uint32_t>(value));
     }
     else if (dest.precision < 19) {
         std::int64_t value = 0;
         readPOD(value);
 
-        if (value < 0) {
-            dest.sign = 0;
-            dest.value = -value;
-        }
-        else {
-            dest.sign = 1;
-            dest.value = value;
-        }
+        dest.sign = (value < 0 ? 0 : 1);
+        dest.value = (value < 0 ? -static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value));
+    }
+    else if (dest.precision < 39) {
+        DecimalMantissaType value = 0;
+        readPOD(value);
+
+        // The value is a two's complement 128-bit integer.
+        const bool negative = ((value >> (sizeof(value) * 8 - 1)) != 0);
+
+        dest.sign = (negative ? 0 : 1);
+        dest.value = (negative ? -value : value);
     }
     else {
-        throw std::runtime_error("Unable to decode value of type 'Decimal' that is represented by 128-bit integer");
+        throw std::runtime_error("Unable to decode value of type 'Decimal' that is represented by an integer wider than 128 bits");
     }
 }
 
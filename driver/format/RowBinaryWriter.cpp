@@ -0,0 +1,258 @@
+#include "driver/format/RowBinaryWriter.h"
+#include "driver/utils/type_parser.h"
+#include "driver/exception.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+template <typename T>
+inline void appendPOD(const T & value, std::string & dest) {
+    dest.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// Unsigned LEB128, as used for the lengths of strings.
+inline void appendSize(std::uint64_t size, std::string & dest) {
+    do {
+        std::uint8_t byte = size & 0x7F;
+        size >>= 7;
+        if (size != 0)
+            byte |= 0x80;
+        dest.push_back(static_cast<char>(byte));
+    } while (size != 0);
+}
+
+template <typename CType, typename T>
+void encodeNumber(const BindingInfo & src, std::size_t, std::string &, std::string & dest) {
+    const auto value = *reinterpret_cast<const CType *>(src.value);
+
+    if constexpr (std::is_floating_point_v<T>) {
+        appendPOD(static_cast<T>(value), dest);
+    }
+    else if constexpr (std::is_floating_point_v<CType>) {
+        // The fractional part is truncated, the integral part must fit. The bounds are powers of 2, so they are exact in any floating point type.
+        const auto integral = std::trunc(value);
+        const auto upper = std::ldexp(CType{1}, std::numeric_limits<T>::digits);
+        const auto lower = (std::is_signed_v<T> ? -upper : CType{0});
+
+        if (!(integral >= lower && integral < upper))
+            throw SqlException("Numeric value out of range", "22003");
+
+        appendPOD(static_cast<T>(integral), dest);
+    }
+    else {
+        if (!std::in_range<T>(value))
+            throw SqlException("Numeric value out of range", "22003");
+
+        appendPOD(static_cast<T>(value), dest);
+    }
+}
+
+template <typename T>
+auto getNumberEncoder(SQLSMALLINT c_type) {
+    using Encoder = void (*)(const BindingInfo &, std::size_t, std::string &, std::string &);
+
+    switch (c_type) {
+        case SQL_C_BIT:      return static_cast<Encoder>(&encodeNumber< SQLCHAR,      T >);
+        case SQL_C_UTINYINT: return static_cast<Encoder>(&encodeNumber< SQLCHAR,      T >);
+        case SQL_C_TINYINT:  return static_cast<Encoder>(&encodeNumber< SQLSCHAR,     T >);
+        case SQL_C_STINYINT: return static_cast<Encoder>(&encodeNumber< SQLSCHAR,     T >);
+        case SQL_C_SHORT:    return static_cast<Encoder>(&encodeNumber< SQLSMALLINT,  T >);
+        case SQL_C_SSHORT:   return static_cast<Encoder>(&encodeNumber< SQLSMALLINT,  T >);
+        case SQL_C_USHORT:   return static_cast<Encoder>(&encodeNumber< SQLUSMALLINT, T >);
+        case SQL_C_LONG:     return static_cast<Encoder>(&encodeNumber< SQLINTEGER,   T >);
+        case SQL_C_SLONG:    return static_cast<Encoder>(&encodeNumber< SQLINTEGER,   T >);
+        case SQL_C_ULONG:    return static_cast<Encoder>(&encodeNumber< SQLUINTEGER,  T >);
+        case SQL_C_SBIGINT:  return static_cast<Encoder>(&encodeNumber< SQLBIGINT,    T >);
+        case SQL_C_UBIGINT:  return static_cast<Encoder>(&encodeNumber< SQLUBIGINT,   T >);
+        case SQL_C_FLOAT:    return static_cast<Encoder>(&encodeNumber< SQLREAL,      T >);
+        case SQL_C_DOUBLE:   return static_cast<Encoder>(&encodeNumber< SQLDOUBLE,    T >);
+    }
+
+    return static_cast<Encoder>(nullptr);
+}
+
+inline int getDaysInMonth(int year, int month) {
+    static constexpr int days_in_month[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool is_leap_year = ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0);
+    return (month == 2 && is_leap_year ? 29 : days_in_month[month - 1]);
+}
+
+void encodeDate(const BindingInfo & src, std::size_t, std::string &, std::string & dest) {
+    const auto & date = *reinterpret_cast<const SQL_DATE_STRUCT *>(src.value);
+
+    if (date.month < 1 || date.month > 12 || date.day < 1 || date.day > getDaysInMonth(date.year, date.month))
+        throw SqlException("Invalid datetime format", "22007");
+
+    const auto days = value_manip::datetime::daysFromCivil(date.year, date.month, date.day);
+    if (!std::in_range<std::uint16_t>(days))
+        throw SqlException("Datetime field overflow", "22008");
+
+    appendPOD(static_cast<std::uint16_t>(days), dest);
+}
+
+// Any value converted to its text representation. Also used for the values that have no encoder for the column type,
+// which are then sent as String, and converted by the server.
+void encodeString(const BindingInfo & src, std::size_t fixed_size, std::string & buffer, std::string & dest) {
+    readReadyDataTo(src, buffer);
+
+    if (fixed_size == 0) {
+        appendSize(buffer.size(), dest);
+        dest += buffer;
+    }
+    else {
+        if (buffer.size() > fixed_size)
+            throw SqlException("String data, right truncated", "22001");
+
+        dest += buffer;
+        dest.append(fixed_size - buffer.size(), '\0');
+    }
+}
+
+std::string quoteIdentifier(const std::string & name) {
+    std::string quoted = "`";
+    for (const auto ch : name) {
+        if (ch == '`' || ch == '\\')
+            quoted += '\\';
+        quoted += ch;
+    }
+    quoted += '`';
+    return quoted;
+}
+
+std::string quoteString(const std::string & value) {
+    std::string quoted = "'";
+    for (const auto ch : value) {
+        if (ch == '\'' || ch == '\\')
+            quoted += '\\';
+        quoted += ch;
+    }
+    quoted += '\'';
+    return quoted;
+}
+
+} // namespace
+
+RowBinaryWriter::RowBinaryWriter(const std::vector<Column> & columns_) {
+    columns.reserve(columns_.size());
+
+    for (const auto & column : columns_) {
+        ColumnEncoder column_encoder;
+        column_encoder.name = column.name;
+
+        TypeAst ast;
+        if (column.type.empty()) {
+            column_encoder.is_nullable = true;
+        }
+        else if (TypeParser{column.type}.parse(&ast)) {
+            // LowCardinality doesn't affect RowBinary representation, Nullable adds a null flag before the value.
+            while (ast.meta == TypeAst::LowCardinality || ast.meta == TypeAst::Nullable) {
+                if (ast.meta == TypeAst::Nullable)
+                    column_encoder.is_nullable = true;
+                if (ast.elements.empty())
+                    break;
+                auto nested = std::move(ast.elements.front());
+                ast = std::move(nested);
+            }
+
+            if (ast.meta == TypeAst::Terminal) {
+                const auto c_type = column.c_type;
+                Encoder encoder = nullptr;
+
+                switch (convertUnparametrizedTypeNameToTypeId(ast.name)) {
+                    case DataSourceTypeId::Int8:    encoder = getNumberEncoder< std::int8_t   >(c_type); break;
+                    case DataSourceTypeId::UInt8:   encoder = getNumberEncoder< std::uint8_t  >(c_type); break;
+                    case DataSourceTypeId::Int16:   encoder = getNumberEncoder< std::int16_t  >(c_type); break;
+                    case DataSourceTypeId::UInt16:  encoder = getNumberEncoder< std::uint16_t >(c_type); break;
+                    case DataSourceTypeId::Int32:   encoder = getNumberEncoder< std::int32_t  >(c_type); break;
+                    case DataSourceTypeId::UInt32:  encoder = getNumberEncoder< std::uint32_t >(c_type); break;
+                    case DataSourceTypeId::Int64:   encoder = getNumberEncoder< std::int64_t  >(c_type); break;
+                    case DataSourceTypeId::UInt64:  encoder = getNumberEncoder< std::uint64_t >(c_type); break;
+                    case DataSourceTypeId::Float32: encoder = getNumberEncoder< float         >(c_type); break;
+                    case DataSourceTypeId::Float64: encoder = getNumberEncoder< double        >(c_type); break;
+
+                    case DataSourceTypeId::String: {
+                        encoder = &encodeString;
+                        break;
+                    }
+
+                    case DataSourceTypeId::FixedString: {
+                        if (ast.elements.size() == 1 && ast.elements.front().size > 0) {
+                            encoder = &encodeString;
+                            column_encoder.fixed_size = ast.elements.front().size;
+                        }
+                        break;
+                    }
+
+                    case DataSourceTypeId::Date: {
+                        if (c_type == SQL_C_DATE || c_type == SQL_C_TYPE_DATE)
+                            encoder = &encodeDate;
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+
+                if (encoder) {
+                    column_encoder.encoder = encoder;
+                    column_encoder.wire_type = (column_encoder.fixed_size > 0 ? "FixedString(" + std::to_string(column_encoder.fixed_size) + ")" : ast.name);
+                    column_encoder.is_native = true;
+                }
+            }
+        }
+        else {
+            column_encoder.is_nullable = (column.type.compare(0, 9, "Nullable(") == 0);
+        }
+
+        if (!column_encoder.encoder) {
+            column_encoder.encoder = &encodeString;
+            column_encoder.wire_type = "String";
+        }
+
+        columns.push_back(std::move(column_encoder));
+    }
+}
+
+std::string RowBinaryWriter::buildInsertQuery(const std::string & table) const {
+    std::string column_list;
+    std::string structure;
+    bool all_native = true;
+
+    for (const auto & column : columns) {
+        if (!column_list.empty()) {
+            column_list += ", ";
+            structure += ", ";
+        }
+
+        column_list += quoteIdentifier(column.name);
+        structure += quoteIdentifier(column.name) + ' ' + (column.is_nullable ? "Nullable(" + column.wire_type + ")" : column.wire_type);
+        all_native = all_native && column.is_native;
+    }
+
+    std::string query = "INSERT INTO " + table + " (" + column_list + ")";
+
+    // Values that are not in the representation of their column type are read as declared, and converted by INSERT SELECT.
+    if (!all_native)
+        query += " SELECT * FROM input(" + quoteString(structure) + ")";
+
+    query += " FORMAT RowBinary";
+    return query;
+}
+
+void RowBinaryWriter::writeValue(std::size_t column_idx, const BindingInfo & src, std::string & dest) {
+    const auto & column = columns.at(column_idx);
+    const bool is_null = (src.value == nullptr || (src.indicator && *src.indicator == SQL_NULL_DATA));
+
+    if (column.is_nullable)
+        dest.push_back(is_null ? 1 : 0);
+    else if (is_null)
+        throw SqlException("Null value for non-nullable column " + column.name, "23000");
+
+    if (!is_null)
+        column.encoder(src, column.fixed_size, buffer, dest);
+}
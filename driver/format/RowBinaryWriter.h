@@ -0,0 +1,47 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+#include "driver/utils/type_info.h"
+
+#include <string>
+#include <vector>
+
+// Serializes values, taken from bound application buffers, into RowBinary wire format of ClickHouse, for inserting them into a table.
+// An encoder is chosen once per column, by the type of the column and the C type of the buffer bound to it. Values that have a direct
+// binary representation in the column type (numbers for numeric columns, any value for String and FixedString, dates for Date) are written
+// in it, the rest are written as text, in a String, and converted to the column type by the server. Values of columns of unknown type
+// are written as Nullable(String).
+class RowBinaryWriter
+{
+public:
+    struct Column {
+        std::string name;
+        std::string type; // Full type of the target column, e.g., "LowCardinality(Nullable(String))", or empty, if unknown.
+        SQLSMALLINT c_type = SQL_C_DEFAULT;
+    };
+
+public:
+    explicit RowBinaryWriter(const std::vector<Column> & columns);
+
+    // INSERT query that reads the rows, serialized by this writer, from the request body.
+    std::string buildInsertQuery(const std::string & table) const;
+
+    // Append a value of a column of the current row, columns must be written in order. The value must be of the C type
+    // the column was declared with. Null data pointer or SQL_NULL_DATA indicator means NULL.
+    void writeValue(std::size_t column_idx, const BindingInfo & src, std::string & dest);
+
+private:
+    using Encoder = void (*)(const BindingInfo & src, std::size_t fixed_size, std::string & buffer, std::string & dest);
+
+    struct ColumnEncoder {
+        std::string name;
+        std::string wire_type; // Type of the values in the body, without Nullable.
+        Encoder encoder = nullptr;
+        std::size_t fixed_size = 0;
+        bool is_nullable = false;
+        bool is_native = false; // Whether the values are written in the representation of the column type itself.
+    };
+
+    std::vector<ColumnEncoder> columns;
+    std::string buffer; // Reused between the values converted via their text representation.
+};
@@ -72,6 +72,9 @@ void readDSNinfo(ConnInfo * ci, bool overwrite) {
     GET_CONFIG(server,          INI_SERVER,          INI_SERVER_DEFAULT);
     GET_CONFIG(port,            INI_PORT,            INI_PORT_DEFAULT);
     GET_CONFIG(timeout,         INI_TIMEOUT,         INI_TIMEOUT_DEFAULT);
+    GET_CONFIG(keep_alive_timeout, INI_KEEP_ALIVE_TIMEOUT, INI_KEEP_ALIVE_TIMEOUT_DEFAULT);
+    GET_CONFIG(retry_count,     INI_RETRY_COUNT,     INI_RETRY_COUNT_DEFAULT);
+    GET_CONFIG(retry_backoff,   INI_RETRY_BACKOFF,   INI_RETRY_BACKOFF_DEFAULT);
     GET_CONFIG(verify_connection_early, INI_VERIFY_CONNECTION_EARLY, INI_VERIFY_CONNECTION_EARLY_DEFAULT);
     GET_CONFIG(sslmode,         INI_SSLMODE,         INI_SSLMODE_DEFAULT);
     GET_CONFIG(database,        INI_DATABASE,        INI_DATABASE_DEFAULT);
@@ -80,6 +83,15 @@ void readDSNinfo(ConnInfo * ci, bool overwrite) {
     GET_CONFIG(driverlog,       INI_DRIVERLOG,       INI_DRIVERLOG_DEFAULT);
     GET_CONFIG(driverlogfile,   INI_DRIVERLOGFILE,   INI_DRIVERLOGFILE_DEFAULT);
     GET_CONFIG(auto_session_id, INI_AUTO_SESSION_ID, INI_AUTO_SESSION_ID_DEFAULT);
+    GET_CONFIG(compress_request, INI_COMPRESS_REQUEST, INI_COMPRESS_REQUEST_DEFAULT);
+    GET_CONFIG(compress_response, INI_COMPRESS_RESPONSE, INI_COMPRESS_RESPONSE_DEFAULT);
+    GET_CONFIG(params_in_body,  INI_PARAMS_IN_BODY,  INI_PARAMS_IN_BODY_DEFAULT);
+    GET_CONFIG(parallel_insert_threshold, INI_PARALLEL_INSERT_THRESHOLD, INI_PARALLEL_INSERT_THRESHOLD_DEFAULT);
+    GET_CONFIG(parallel_insert_streams, INI_PARALLEL_INSERT_STREAMS, INI_PARALLEL_INSERT_STREAMS_DEFAULT);
+    GET_CONFIG(buffered_insert_max_rows, INI_BUFFERED_INSERT_MAX_ROWS, INI_BUFFERED_INSERT_MAX_ROWS_DEFAULT);
+    GET_CONFIG(buffered_insert_max_bytes, INI_BUFFERED_INSERT_MAX_BYTES, INI_BUFFERED_INSERT_MAX_BYTES_DEFAULT);
+    GET_CONFIG(buffered_insert_flush_interval, INI_BUFFERED_INSERT_FLUSH_INTERVAL, INI_BUFFERED_INSERT_FLUSH_INTERVAL_DEFAULT);
+    GET_CONFIG(infer_param_types, INI_INFER_PARAM_TYPES, INI_INFER_PARAM_TYPES_DEFAULT);
 
 #undef GET_CONFIG
 }
@@ -114,6 +126,9 @@ void writeDSNinfo(const ConnInfo * ci) {
     WRITE_CONFIG(server,          INI_SERVER);
     WRITE_CONFIG(port,            INI_PORT);
     WRITE_CONFIG(timeout,         INI_TIMEOUT);
+    WRITE_CONFIG(keep_alive_timeout, INI_KEEP_ALIVE_TIMEOUT);
+    WRITE_CONFIG(retry_count,     INI_RETRY_COUNT);
+    WRITE_CONFIG(retry_backoff,   INI_RETRY_BACKOFF);
     WRITE_CONFIG(verify_connection_early, INI_VERIFY_CONNECTION_EARLY);
     WRITE_CONFIG(sslmode,         INI_SSLMODE);
     WRITE_CONFIG(database,        INI_DATABASE);
@@ -122,6 +137,15 @@ void writeDSNinfo(const ConnInfo * ci) {
     WRITE_CONFIG(driverlog,       INI_DRIVERLOG);
     WRITE_CONFIG(driverlogfile,   INI_DRIVERLOGFILE);
     WRITE_CONFIG(auto_session_id, INI_AUTO_SESSION_ID);
+    WRITE_CONFIG(compress_request, INI_COMPRESS_REQUEST);
+    WRITE_CONFIG(compress_response, INI_COMPRESS_RESPONSE);
+    WRITE_CONFIG(params_in_body,  INI_PARAMS_IN_BODY);
+    WRITE_CONFIG(parallel_insert_threshold, INI_PARALLEL_INSERT_THRESHOLD);
+    WRITE_CONFIG(parallel_insert_streams, INI_PARALLEL_INSERT_STREAMS);
+    WRITE_CONFIG(buffered_insert_max_rows, INI_BUFFERED_INSERT_MAX_ROWS);
+    WRITE_CONFIG(buffered_insert_max_bytes, INI_BUFFERED_INSERT_MAX_BYTES);
+    WRITE_CONFIG(buffered_insert_flush_interval, INI_BUFFERED_INSERT_FLUSH_INTERVAL);
+    WRITE_CONFIG(infer_param_types, INI_INFER_PARAM_TYPES);
 
 #undef WRITE_CONFIG
 }
@@ -161,14 +161,7 @@ std::unique_ptr<ResultReader> make_result_reader(const std::string & format, con
 
 template <typename ConversionContext>
 SQLRETURN Field::extract(BindingInfo & binding_info, ConversionContext && context) const {
-    return std::visit([&binding_info, &context] (auto & value) {
-        if constexpr (std::is_same_v<DataSourceType<DataSourceTypeId::Nothing>, std::decay_t<decltype(value)>>) {
-            return fillOutputNULL(binding_info.value, binding_info.value_max_size, binding_info.indicator);
-        }
-        else {
-            return writeDataFrom(value, binding_info, std::forward<ConversionContext>(context));
-        }
-    }, data);
+    return writeDataFrom(data, binding_info, std::forward<ConversionContext>(context));
 }
 
 template <typename ConversionContext>
@@ -1,7 +1,9 @@
 #include "driver/platform/platform.h"
 #include "driver/utils/utils.h"
+#include "driver/utils/retry_policy.h"
 #include "driver/escaping/lexer.h"
 #include "driver/escaping/escape_sequences.h"
+#include "driver/format/RowBinaryWriter.h"
 #include "driver/statement.h"
 
 #include <Poco/Exception.h>
@@ -10,45 +12,69 @@
 #include <Poco/Net/HTTPSClientSession.h>
 #endif
 #include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/MultipartWriter.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/String.h>
 #include <Poco/Timezone.h>
 #include <Poco/URI.h>
-#include <Poco/UUID.h>
-#include <Poco/UUIDGenerator.h>
 
+#include <algorithm>
+#include <array>
 #include <cctype>
 #include <cstdio>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <system_error>
+#include <thread>
 
 Statement::Statement(Connection & connection)
     : ChildType(connection)
 {
     allocateImplicitDescriptors();
-    
-    // Create independent HTTP session for this statement to avoid concurrent access issues
-    auto& conn = getParent();
-    
+
+    // Independent HTTP session for each statement to avoid concurrent access issues
+    statement_session = makeSession();
+}
+
+Statement::~Statement() {
+    if (async_result.valid()) {
+        cancel_requested = true;
+        async_result.wait();
+    }
+
+    if (bulk_add_result.valid())
+        bulk_add_result.wait();
+
+    deallocateImplicitDescriptors();
+}
+
+std::unique_ptr<Poco::Net::HTTPClientSession> Statement::makeSession() {
+    auto & conn = getParent();
+    std::unique_ptr<Poco::Net::HTTPClientSession> session;
+
 #if !defined(WORKAROUND_DISABLE_SSL)
     const auto is_ssl = (Poco::UTF8::icompare(conn.getProto(), "https") == 0);
-    statement_session = (
+    session = (
         is_ssl ? std::make_unique<Poco::Net::HTTPSClientSession>() :
         std::make_unique<Poco::Net::HTTPClientSession>()
     );
 #else
-    statement_session = std::make_unique<Poco::Net::HTTPClientSession>();
+    session = std::make_unique<Poco::Net::HTTPClientSession>();
 #endif
-    
-    statement_session->setHost(conn.getServer());
-    statement_session->setPort(conn.getPort());
-    statement_session->setKeepAlive(true);
-    statement_session->setTimeout(
-        Poco::Timespan(conn.getConnectionTimeout(), 0), 
-        Poco::Timespan(conn.getTimeout(), 0), 
+
+    session->setHost(conn.getServer());
+    session->setPort(conn.getPort());
+    session->setKeepAlive(true);
+    session->setTimeout(
+        Poco::Timespan(conn.getConnectionTimeout(), 0),
+        Poco::Timespan(conn.getTimeout(), 0),
         Poco::Timespan(conn.getTimeout(), 0)
     );
-    statement_session->setKeepAliveTimeout(Poco::Timespan(86400, 0));
-}
+    session->setKeepAliveTimeout(Poco::Timespan(conn.keep_alive_timeout, 0));
 
-Statement::~Statement() {
-    deallocateImplicitDescriptors();
+    return session;
 }
 
 const TypeInfo & Statement::getTypeInfo(const std::string & type_name, const std::string & type_name_without_parameters) const {
@@ -59,10 +85,44 @@ void Statement::prepareQuery(const std::string & q) {
     closeCursor();
 
     is_prepared = false;
-    query = q;
-    processEscapeSequences();
-    extractParametersinfo();
+
+    // Escape sequence processing and parameter extraction depend only on the text and SQL_ATTR_NOSCAN, so their results are reused
+    // for the queries that are prepared repeatedly.
+    auto & connection = getParent();
+    const bool noscan = (getAttrAs<SQLULEN>(SQL_ATTR_NOSCAN, SQL_NOSCAN_OFF) == SQL_NOSCAN_ON);
+    const bool cacheable = (q.size() <= Connection::max_cached_query_size);
+
+    std::string cache_key;
+    std::shared_ptr<const PreparedQueryTemplate> cached;
+
+    if (cacheable) {
+        cache_key.reserve(q.size() + 1);
+        cache_key += (noscan ? '1' : '0');
+        cache_key += q;
+    }
+
+    if (cacheable && connection.prepared_queries.tryGet(cache_key, cached)) {
+        query = cached->query;
+        parameters = cached->parameters;
+    }
+    else {
+        auto prepared = std::make_shared<const PreparedQueryTemplate>(prepareQueryTemplate(q, !noscan));
+        query = prepared->query;
+        parameters = prepared->parameters;
+
+        if (cacheable)
+            connection.prepared_queries.put(cache_key, std::move(prepared));
+    }
+
+    resetParamDescriptors();
+    param_encodings_valid = false;
+    param_layout_valid = false;
+    param_column_types_valid = false;
     is_prepared = true;
+
+    // Describing the table runs a query on a new statement handle, which must not be allocated on the worker of an asynchronous execution.
+    if (connection.infer_param_types)
+        getParamColumnTypes();
 }
 
 bool Statement::isPrepared() const {
@@ -87,20 +147,81 @@ void Statement::executeQuery(std::unique_ptr<ResultMutator> && mutator) {
         *param_set_processed_ptr = 0;
 
     next_param_set_idx = 0;
+    param_encodings_valid = false;
+    param_layout_valid = false;
+
+    if (tryExecuteParallelInsert() || tryBufferInsert()) {
+        is_executed = true;
+        return;
+    }
+
     requestNextPackOfResultSets(std::move(mutator));
     is_executed = true;
 }
 
-Statement::HttpRequestData Statement::prepareHttpRequest()
-{
-    Statement::HttpRequestData ret{};
-    const auto& connection = getParent();
-    const auto param_bindings = getParamsBindingInfo(next_param_set_idx);
+// Same as Poco::URI::addQueryParameter(), but for an already encoded path and query string.
+static void appendQueryParameter(std::string & path_and_query, const std::string & name, const std::string & value) {
+    static const std::string reserved_query_param = "?#/:;+@&="; // Same as Poco::URI::RESERVED_QUERY_PARAM.
+
+    path_and_query += (path_and_query.find('?') == std::string::npos ? '?' : '&');
+    Poco::URI::encode(name, reserved_query_param, path_and_query);
+    path_and_query += '=';
+    Poco::URI::encode(value, reserved_query_param, path_and_query);
+}
+
+// Check, without blocking, that a kept-alive connection hasn't been closed by the server (or a load balancer) while idle.
+// There must be nothing to read from an idle HTTP connection, so readability means EOF/RST (or garbage) and the connection is unusable.
+static bool isIdleConnectionAlive(Poco::Net::HTTPClientSession & session) {
+    if (!session.connected())
+        return true;
+
+    try {
+        return !session.socket().poll(Poco::Timespan(0), Poco::Net::Socket::SELECT_READ | Poco::Net::Socket::SELECT_ERROR);
+    }
+    catch (const Poco::Exception &) {
+        return false;
+    }
+}
+
+// Check whether the value of the parameter is to be provided by SQLPutData() calls, at execution time.
+static bool isDataAtExecParam(const BindingInfo & binding_info) {
+    const auto * ind_ptr = (binding_info.indicator ? binding_info.indicator : binding_info.value_size);
+    return (ind_ptr && (*ind_ptr == SQL_DATA_AT_EXEC || *ind_ptr <= SQL_LEN_DATA_AT_EXEC_OFFSET));
+}
+
+// Write the header of a multipart/form-data part. The value follows, terminated with CRLF.
+static void writeMultipartPartHeader(std::ostream & out, const std::string & boundary, const std::string & name) {
+    out << "--" << boundary << "\r\n"
+        << "Content-Disposition: form-data; name=\"" << name << "\"\r\n"
+        << "\r\n";
+}
+
+static void throwOnErrorResponse(Poco::Net::HTTPResponse & response, std::istream & in, int redirect_limit, SQLULEN query_timeout) {
+    const auto status = response.getStatus();
+    if (status == Poco::Net::HTTPResponse::HTTP_OK)
+        return;
+
+    std::stringstream error_message;
+    if (status == Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT || status == Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT) {
+        error_message << "Redirect count exceeded" << std::endl << "Redirect limit: " << redirect_limit << std::endl;
+    } else {
+        error_message << "HTTP status code: " << status << std::endl << "Received error:" << std::endl << in.rdbuf() << std::endl;
+    }
+    LOG(error_message.str());
+    if (query_timeout > 0 && error_message.str().find("TIMEOUT_EXCEEDED") != std::string::npos)
+        throw SqlException(error_message.str(), "HYT00");
+    throw std::runtime_error(error_message.str());
+}
+
+template <typename Callback>
+void Statement::forEachParamValue(const std::vector<ParamBindingInfo> & param_bindings, Callback && callback) {
+    const auto & encodings = getParamEncodings(param_bindings);
+    std::string value;
 
     for (std::size_t i = 0; i < parameters.size(); ++i) {
-        std::string value;
+        const auto & encoding = encodings[i];
 
-        if (param_bindings.size() <= i) {
+        if (!encoding.is_bound) {
             value = "\\N";
         }
         else {
@@ -109,22 +230,77 @@ Statement::HttpRequestData Statement::prepareHttpRequest()
             if (!isInputParam(binding_info.io_type) || isStreamParam(binding_info.io_type))
                 throw std::runtime_error("Unable to extract data from bound param buffer: param IO type is not supported");
 
+            // Values of data-at-execution parameters are streamed into the request separately.
+            if (isDataAtExecParam(binding_info))
+                continue;
+
             if (binding_info.value == nullptr)
                 value = "\\N";
+            else if (encoding.read)
+                encoding.read(binding_info, value);
             else
-                readReadyDataTo(binding_info, value);
+                throw std::runtime_error("Unable to extract data from bound buffer: source type representation not supported");
         }
 
-        const auto param_name = getParamFinalName(i);
-        ret.params.emplace("param_" + param_name, value);
+        callback(encoding.http_name, value);
     }
+}
+
+Statement::HttpRequestData Statement::prepareHttpRequest()
+{
+    Statement::HttpRequestData ret{};
+    param_encodings_valid = false;
+    param_layout_valid = false;
+    const auto param_bindings = getParamsBindingInfo(next_param_set_idx);
+
+    forEachParamValue(param_bindings, [&] (const std::string & name, const std::string & value) {
+        ret.params.emplace(name, value);
+    });
 
     ret.query = buildFinalQuery(param_bindings);
     return ret;
 }
 
+void Statement::writeMultipartHttpRequest(std::ostream & out, const std::string & boundary) {
+    param_encodings_valid = false;
+    param_layout_valid = false;
+    const auto param_bindings = getParamsBindingInfo(next_param_set_idx);
+    writeMultipartHttpRequest(out, boundary, buildFinalQuery(param_bindings), param_bindings);
+}
+
+void Statement::writeMultipartHttpRequest(std::ostream & out, const std::string & boundary, const std::string & query, const std::vector<ParamBindingInfo> & param_bindings, bool finish) {
+    const auto write_part = [&] (const std::string & name, const std::string & value) {
+        writeMultipartPartHeader(out, boundary, name);
+        out.write(value.data(), value.size());
+        out << "\r\n";
+    };
+
+    write_part("query", query);
+    forEachParamValue(param_bindings, write_part);
+
+    if (finish)
+        out << "--" << boundary << "--\r\n";
+}
+
+void Statement::initRequest(Poco::Net::HTTPRequest & request, const std::string & path_and_query) {
+    initRequest(request, path_and_query, getParent().getRequestTemplate());
+}
+
+void Statement::initRequest(Poco::Net::HTTPRequest & request, const std::string & path_and_query, const Connection::RequestTemplate & request_template) {
+    request.setMethod(Poco::Net::HTTPRequest::HTTP_POST);
+    request.setVersion(Poco::Net::HTTPRequest::HTTP_1_1);
+    request.setKeepAlive(true);
+    request.setChunkedTransferEncoding(true);
+    request.setCredentials("Basic", request_template.credentials);
+    request.setURI(path_and_query);
+    request.set("User-Agent", request_template.user_agent);
+}
+
 void Statement::requestNextPackOfResultSets(std::unique_ptr<ResultMutator> && mutator) {
-    result_reader.reset();
+    closeResultReader();
+
+    // An execution abandoned while waiting for data can't be completed anymore.
+    abortDataAtExecution();
 
     const auto param_set_array_size = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
     if (next_param_set_idx >= param_set_array_size)
@@ -138,88 +314,282 @@ void Statement::requestNextPackOfResultSets(std::unique_ptr<ResultMutator> && mu
         if (in->fail() || !in->eof())
             statement_session->reset();
 
-    const auto [prepared_query, query_parameters] = prepareHttpRequest();
-    Poco::URI uri = connection.getUri();
+    std::string path_and_query = connection.getRequestTemplate().path_and_query;
+    auto param_bindings = getParamsBindingInfo(next_param_set_idx);
+    const auto prepared_query = buildFinalQuery(param_bindings);
 
-    for (const auto& [key, value]: query_parameters) {
-        uri.addQueryParameter(key, value);
+    std::vector<std::size_t> data_at_exec_param_indices;
+    for (std::size_t i = 0; i < param_bindings.size(); ++i) {
+        if (isDataAtExecParam(param_bindings[i]))
+            data_at_exec_param_indices.push_back(i);
     }
 
+    if (!data_at_exec_param_indices.empty() && param_set_array_size > 1)
+        throw SqlException("Optional feature not implemented: data-at-execution parameters in arrays of parameters", "HYC00");
+
+    // In multipart mode, parameter values are converted and written straight into the request body, when it is being sent.
+    // Values of data-at-execution parameters are streamed into the body as well, so they require this mode.
+    const bool params_in_body = (connection.params_in_body || !data_at_exec_param_indices.empty());
+
+    if (!params_in_body) {
+        forEachParamValue(param_bindings, [&] (const std::string & name, const std::string & value) {
+            appendQueryParameter(path_and_query, name, value);
+        });
+    }
+
+    // Let the server abort the query on timeout, and stop producing rows that the application will never fetch.
+    // Unlike max_result_rows, the limit setting applies only to the final result, not to subqueries.
+    const auto query_timeout = getAttrAs<SQLULEN>(SQL_ATTR_QUERY_TIMEOUT, 0);
+    if (query_timeout > 0)
+        appendQueryParameter(path_and_query, "max_execution_time", std::to_string(query_timeout));
+
+    const auto max_rows = getAttrAs<SQLULEN>(SQL_ATTR_MAX_ROWS, 0);
+    if (max_rows > 0)
+        appendQueryParameter(path_and_query, "limit", std::to_string(max_rows));
+
+    // Client-side deadline, in case the server doesn't respond in time: a bit longer than the query timeout, so that the server's own error, if any, arrives first.
+    statement_session->setTimeout(
+        Poco::Timespan(connection.getConnectionTimeout(), 0),
+        Poco::Timespan(connection.getTimeout(), 0),
+        Poco::Timespan(query_timeout > 0 ? query_timeout + 1 : connection.getTimeout(), 0)
+    );
+
     // TODO: set this only after this single query is fully fetched (when output parameter support is added)
     auto * param_set_processed_ptr = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).getAttrAs<SQLULEN *>(SQL_DESC_ROWS_PROCESSED_PTR, 0);
     if (param_set_processed_ptr)
         *param_set_processed_ptr = next_param_set_idx;
 
+    // The request is sent when the application is asked for the first value, see nextDataAtExecParam().
+    if (!data_at_exec_param_indices.empty()) {
+        data_at_execution = std::make_unique<DataAtExecution>();
+        data_at_execution->path_and_query = std::move(path_and_query);
+        data_at_execution->query = prepared_query;
+        data_at_execution->param_bindings = std::move(param_bindings);
+        data_at_execution->param_indices = std::move(data_at_exec_param_indices);
+        data_at_execution->query_timeout = query_timeout;
+        data_at_execution->mutator = std::move(mutator);
+        return;
+    }
+
     Poco::Net::HTTPRequest request;
-    request.setMethod(Poco::Net::HTTPRequest::HTTP_POST);
-    request.setVersion(Poco::Net::HTTPRequest::HTTP_1_1);
-    request.setKeepAlive(true);
-    request.setChunkedTransferEncoding(true);
-    request.setCredentials("Basic", connection.buildCredentialsString());
-    request.setHost(uri.getHost());
-    request.setURI(uri.getPathEtc());
-    request.set("User-Agent", connection.buildUserAgentString());
+    initRequest(request, path_and_query);
 
-    LOG(request.getMethod() << " " << request.getHost() << request.getURI() << " body=" << prepared_query
+    // Multipart body is parsed by the server before Content-Encoding is applied, so it is never compressed.
+    const auto compression = (
+        !params_in_body && prepared_query.size() >= min_compressed_request_body_size ?
+        connection.compress_request : CompressionMethod::None
+    );
+    if (compression != CompressionMethod::None)
+        request.set("Content-Encoding", getContentEncoding(compression));
+
+    std::string multipart_boundary;
+    if (params_in_body) {
+        multipart_boundary = Poco::Net::MultipartWriter::createBoundary();
+        request.setContentType("multipart/form-data; boundary=" + multipart_boundary);
+    }
+
+    LOG(request.getMethod() << " " << request.getURI() << " body=" << prepared_query
                             << " UA=" << request.get("User-Agent"));
 
-    int redirect_count = 0;
-    // Send request to server with finite count of retries.
+    in = nullptr; // The stream of the previous response, if any, is destroyed by the next request.
+    in = &sendRequest(*statement_session, request, response, isIdempotentQuery(prepared_query), query_timeout, connection.getRetryPolicy(), connection.redirect_limit, [&] (std::ostream & request_stream) {
+        if (params_in_body) {
+            writeMultipartHttpRequest(request_stream, multipart_boundary, prepared_query, param_bindings);
+        }
+        else if (compression == CompressionMethod::None) {
+            request_stream << prepared_query;
+        }
+        else {
+            CompressingOutputStream compressing_stream(request_stream, compression);
+            compressing_stream << prepared_query;
+            compressing_stream.close();
+        }
+    });
+
+    receiveResultSets(std::move(mutator));
+}
+
+void Statement::receiveResultSets(std::unique_ptr<ResultMutator> && mutator) {
+    auto & connection = getParent();
+
+    if (connection.compress_response)
+        decompressed_in = std::make_unique<CompressedBlockInputStream>(*in);
+
+    result_reader = make_result_reader(
+        response->get("X-ClickHouse-Format", connection.default_format),
+        response->get("X-ClickHouse-Timezone", Poco::Timezone::name()),
+        (decompressed_in ? *decompressed_in : *in), std::move(mutator)
+    );
+
+    ++next_param_set_idx;
+}
+
+std::istream & Statement::sendRequest(
+    Poco::Net::HTTPClientSession & session,
+    Poco::Net::HTTPRequest & request,
+    std::unique_ptr<Poco::Net::HTTPResponse> & response,
+    bool idempotent,
+    SQLULEN query_timeout,
+    RetryPolicy retry_policy,
+    int redirect_limit,
+    const std::function<void (std::ostream &)> & write_body
+) {
+    auto & connection = getParent();
+
+    std::istream * in = nullptr;
+    std::size_t failed_host_idx = HostPool::npos;
+
+    // Redirects are followed within a single attempt, each attempt starts from the original request.
+    const auto original_uri = request.getURI();
+
+    // Send request to server with finite count of retries. Each retry goes to the best healthy replica, other than the one that has just failed.
+    // Non-idempotent queries are retried only if the failure happened before any part of the response arrived.
     for (int i = 1;; ++i) {
+        if (cancel_requested)
+            throw SqlException("Operation canceled", "HY008");
+
+        const auto host_idx = connection.hosts.pick(failed_host_idx);
+        const auto endpoint = connection.hosts.getEndpoint(host_idx);
+        auto & circuit_breaker = CircuitBreaker::forEndpoint(endpoint.host, endpoint.port);
+
+        if (!circuit_breaker.allowRequest()) {
+            // With a single replica, there is nothing to fail over to, so the request is sent anyway, but it is not retried,
+            // so that the clients don't keep an overloaded server busy with their retries.
+            if (connection.hosts.size() == 1) {
+                LOG("Http request to " << endpoint.host << ":" << endpoint.port << " try=" << i << " is the last one: too many recent failures");
+                retry_policy.max_retries = std::min(retry_policy.max_retries, i - 1);
+            }
+            else {
+                LOG("Http request to " << endpoint.host << ":" << endpoint.port << " try=" << i << "/" << retry_policy.max_retries << " skipped: too many recent failures");
+                failed_host_idx = host_idx;
+                if (i > retry_policy.max_retries)
+                    throw std::runtime_error("Too many recent failures of requests to " + endpoint.host + ":" + std::to_string(endpoint.port) + ", not sending requests to it for a while");
+                continue;
+            }
+        }
+
+        if (session.getHost() != endpoint.host || session.getPort() != endpoint.port) {
+            session.reset();
+            session.setHost(endpoint.host);
+            session.setPort(endpoint.port);
+        }
+
+        request.setHost(endpoint.host);
+        request.setURI(original_uri);
+
+        const auto started_at = HostPool::Clock::now();
+        bool request_sent = false;
         try {
-            for (; redirect_count < connection.redirect_limit; ++redirect_count) {
-                statement_session->sendRequest(request) << prepared_query;
+            for (int redirect_count = 0; redirect_count < redirect_limit; ++redirect_count) {
+                if (!isIdleConnectionAlive(session)) {
+                    LOG("Kept-alive connection to " << session.getHost() << ":" << session.getPort() << " was closed by peer, reconnecting");
+                    session.reset();
+                }
+
+                request_sent = false;
+                write_body(session.sendRequest(request));
+                request_sent = true;
                 response = std::make_unique<Poco::Net::HTTPResponse>();
-                in = &statement_session->receiveResponse(*response);
+                in = &session.receiveResponse(*response);
                 auto status = response->getStatus();
                 if (status != Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT && status != Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT) {
                     break;
                 }
-                statement_session->reset(); // reset keepalived connection
+                session.reset(); // reset keepalived connection
                 auto newLocation = response->get("Location");
-                LOG("Redirected to " << newLocation << ", redirect index=" << redirect_count + 1 << "/" << connection.redirect_limit);
-                uri = newLocation;
-                statement_session->setHost(uri.getHost());
-                statement_session->setPort(uri.getPort());
+                LOG("Redirected to " << newLocation << ", redirect index=" << redirect_count + 1 << "/" << redirect_limit);
+                const Poco::URI uri(newLocation);
+                session.setHost(uri.getHost());
+                session.setPort(uri.getPort());
                 request.setHost(uri.getHost());
                 request.setURI(uri.getPathEtc());
             }
-            break;
-        } catch (const Poco::IOException & e) {
-            statement_session->reset(); // reset keepalived connection
-            LOG("Http request try=" << i << "/" << connection.retry_count << " failed: " << e.what() << ": " << e.message());
-            if (i > connection.retry_count)
+
+            // The server (or a proxy in front of it) may be overloaded and have rejected the query without executing it.
+            const auto status = response->getStatus();
+            const auto response_action = retry_policy.getResponseAction(i, status);
+
+            if (!response_action.endpoint_failed) {
+                connection.hosts.reportSuccess(host_idx, HostPool::Clock::now() - started_at);
+                circuit_breaker.reportSuccess();
+                break;
+            }
+
+            connection.hosts.reportFailure(host_idx);
+            failed_host_idx = host_idx;
+
+            if (response_action.trip_breaker)
+                circuit_breaker.reportFailure();
+
+            // The rejection of the last attempt is reported by throwOnErrorResponse().
+            if (!response_action.retry)
+                break;
+
+            auto delay = retry_policy.getBackoff(i);
+            RetryPolicy::Clock::duration retry_after;
+            if (tryParseRetryAfter(response->get("Retry-After", ""), retry_after))
+                delay = std::min(retry_after, RetryPolicy::max_retry_after);
+
+            session.reset(); // reset keepalived connection, the response body is not needed
+
+            LOG("Http request to " << endpoint.host << ":" << endpoint.port << " try=" << i << "/" << retry_policy.max_retries << " rejected with status " << status
+                << ", retrying in " << std::chrono::duration_cast<std::chrono::milliseconds>(delay).count() << " ms");
+            sleepBeforeRetry(delay);
+            continue;
+        } catch (const Poco::Exception & e) {
+            // Timeouts are not I/O errors in Poco, but they are handled alike, unless the query has run out of its own time limit.
+            const bool timeout = (dynamic_cast<const Poco::TimeoutException *>(&e) != nullptr);
+            if (!timeout && dynamic_cast<const Poco::IOException *>(&e) == nullptr)
                 throw;
-        }
-    }
 
-    Poco::Net::HTTPResponse::HTTPStatus status = response->getStatus();
-    if (status != Poco::Net::HTTPResponse::HTTP_OK) {
-        std::stringstream error_message;
-        if (status == Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT || status == Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT) {
-            error_message << "Redirect count exceeded" << std::endl << "Redirect limit: " << connection.redirect_limit << std::endl;
-        } else {
-            error_message << "HTTP status code: " << status << std::endl << "Received error:" << std::endl << in->rdbuf() << std::endl;
+            session.reset(); // reset keepalived connection
+
+            // The session has been aborted by SQLCancel, the endpoint is not to blame.
+            if (cancel_requested)
+                throw SqlException("Operation canceled", "HY008");
+
+            RequestFailure failure;
+            failure.timeout = timeout;
+            failure.request_sent = request_sent;
+
+            // NoMessageException means that the connection was closed before any byte of the response was received.
+            failure.no_response = (!request_sent || dynamic_cast<const Poco::Net::NoMessageException *>(&e) != nullptr);
+
+            const auto action = retry_policy.getFailureAction(i, failure, idempotent, query_timeout > 0);
+            if (action == FailureAction::QueryTimeout) {
+                LOG("Http request to " << endpoint.host << ":" << endpoint.port << " timed out: " << e.message());
+                throw SqlException("Query timeout expired", "HYT00");
+            }
+
+            connection.hosts.reportFailure(host_idx);
+            circuit_breaker.reportFailure();
+            failed_host_idx = host_idx;
+
+            LOG("Http request to " << endpoint.host << ":" << endpoint.port << " try=" << i << "/" << retry_policy.max_retries << " failed: " << e.what() << ": " << e.message());
+            if (action == FailureAction::Fail)
+                throw;
+
+            sleepBeforeRetry(retry_policy.getBackoff(i));
         }
-        LOG(error_message.str());
-        throw std::runtime_error(error_message.str());
     }
 
-    result_reader = make_result_reader(
-        response->get("X-ClickHouse-Format", connection.default_format),
-        response->get("X-ClickHouse-Timezone", Poco::Timezone::name()),
-        *in, std::move(mutator)
-    );
-
-    ++next_param_set_idx;
+    throwOnErrorResponse(*response, *in, redirect_limit, query_timeout);
+    return *in;
 }
 
-void Statement::processEscapeSequences() {
-    if (getAttrAs<SQLULEN>(SQL_ATTR_NOSCAN, SQL_NOSCAN_OFF) != SQL_NOSCAN_ON)
-        query = replaceEscapeSequences(query);
+void Statement::sleepBeforeRetry(RetryPolicy::Clock::duration delay) {
+    constexpr auto slice = std::chrono::milliseconds(50);
+    const auto deadline = RetryPolicy::Clock::now() + delay;
+
+    for (auto now = RetryPolicy::Clock::now(); now < deadline; now = RetryPolicy::Clock::now()) {
+        if (cancel_requested)
+            throw SqlException("Operation canceled", "HY008");
+
+        std::this_thread::sleep_for(std::min<RetryPolicy::Clock::duration>(deadline - now, slice));
+    }
 }
 
-void Statement::extractParametersinfo() {
+void Statement::resetParamDescriptors() {
     auto & apd_desc = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
     auto & ipd_desc = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC);
 
@@ -230,106 +600,125 @@ void Statement::extractParametersinfo() {
     ipd_record_count = std::min(ipd_record_count, apd_record_count);
     ipd_desc.setAttr(SQL_DESC_COUNT, ipd_record_count);
 
-    parameters.clear();
+    // Access the biggest record to [possibly] create all missing ones.
+    if (ipd_record_count < parameters.size())
+        ipd_desc.getRecord(parameters.size(), SQL_ATTR_IMP_PARAM_DESC);
+}
+
+// Size and signedness of a numeric type. Size is 0 for the other types.
+struct NumericWidth {
+    std::size_t bits = 0;
+    bool is_signed = false;
+    bool is_float = false;
+};
+
+static NumericWidth getNumericWidth(DataSourceTypeId type_id) {
+    switch (type_id) {
+        case DataSourceTypeId::Int8:    return {8, true, false};
+        case DataSourceTypeId::UInt8:   return {8, false, false};
+        case DataSourceTypeId::Int16:   return {16, true, false};
+        case DataSourceTypeId::UInt16:  return {16, false, false};
+        case DataSourceTypeId::Int32:   return {32, true, false};
+        case DataSourceTypeId::UInt32:  return {32, false, false};
+        case DataSourceTypeId::Int64:   return {64, true, false};
+        case DataSourceTypeId::UInt64:  return {64, false, false};
+        case DataSourceTypeId::Float32: return {32, true, true};
+        case DataSourceTypeId::Float64: return {64, true, true};
+        default:                        return {};
+    }
+}
 
-    // TODO: implement this all in an upgraded Lexer.
+static NumericWidth getNumericWidth(SQLSMALLINT c_type) {
+    switch (c_type) {
+        case SQL_C_BIT:
+        case SQL_C_UTINYINT: return {8, false, false};
+        case SQL_C_TINYINT:
+        case SQL_C_STINYINT: return {8, true, false};
+        case SQL_C_SHORT:
+        case SQL_C_SSHORT:   return {16, true, false};
+        case SQL_C_USHORT:   return {16, false, false};
+        case SQL_C_LONG:
+        case SQL_C_SLONG:    return {32, true, false};
+        case SQL_C_ULONG:    return {32, false, false};
+        case SQL_C_SBIGINT:  return {64, true, false};
+        case SQL_C_UBIGINT:  return {64, false, false};
+        case SQL_C_FLOAT:    return {32, true, true};
+        case SQL_C_DOUBLE:   return {64, true, true};
+        default:             return {};
+    }
+}
 
-    Poco::UUIDGenerator uuid_gen;
-    auto generate_placeholder = [&] () {
-        std::string placeholder;
-        do {
-            const auto uuid = uuid_gen.createOne();
-            placeholder = '@' + uuid.toString();
-        } while (query.find(placeholder) != std::string::npos);
-        return placeholder;
+// Get the type of the substitution of a parameter from the type of the table column it is inserted into, or compared with.
+// The value is sent in the text representation of its C type, so only the column types that can hold every value of it are used.
+static bool tryInferParamType(const std::string & column_type, SQLSMALLINT c_type, std::string & type) {
+    const auto unwrap = [] (std::string & name, const std::string & wrapper) {
+        if (name.size() > wrapper.size() + 1 && name.compare(0, wrapper.size(), wrapper) == 0 && name[wrapper.size()] == '(' && name.back() == ')') {
+            name = name.substr(wrapper.size() + 1, name.size() - wrapper.size() - 2);
+            return true;
+        }
+        return false;
     };
 
-    // Replace all unquoted ? characters with a placeholder and populate 'parameters' array.
-    char quoted_by = '\0';
-    for (std::size_t i = 0; i < query.size(); ++i) {
-        const char curr = query[i];
-        const char next = (i < query.size() ? query[i + 1] : '\0');
-
-        switch (curr) {
-            case '\\': {
-                ++i; // Skip the next char unconditionally.
-                break;
-            }
+    // LowCardinality doesn't matter for a single value.
+    auto base_type = column_type;
+    unwrap(base_type, "LowCardinality");
 
-            case '"':
-            case '\'': {
-                if (quoted_by == curr) {
-                    if (next == curr) {
-                        ++i; // Skip the next char unconditionally: '' or "" SQL escaping.
-                        break;
-                    }
-                    else {
-                        quoted_by = '\0';
-                    }
-                }
-                else {
-                    quoted_by = curr;
-                }
-                break;
-            }
+    auto nested_type = base_type;
+    unwrap(nested_type, "Nullable");
 
-            case '?': {
-                if (quoted_by == '\0') {
-                    ParamInfo param_info;
-                    param_info.tmp_placeholder = generate_placeholder();
-                    query.replace(i, 1, param_info.tmp_placeholder);
-                    i += param_info.tmp_placeholder.size() - 1; // - 1 to compensate for's next ++i
-                    parameters.emplace_back(param_info);
-                }
-                break;
-            }
+    const auto type_id = convertUnparametrizedTypeNameToTypeId(nested_type.substr(0, nested_type.find('(')));
 
-            case '@': {
-                if (quoted_by == '\0') {
-                    ParamInfo param_info;
-
-                    param_info.name = '@';
-                    for (std::size_t j = i + 1; j < query.size(); ++j) {
-                        const char jcurr = query[j];
-                        if (
-                            jcurr == '_' ||
-                            std::isalpha(jcurr) ||
-                            (std::isdigit(jcurr) && j > i + 1)
-                        ) {
-                            param_info.name += jcurr;
-                        }
-                        else {
-                            break;
-                        }
-                    }
+    bool is_parsable = false;
+    switch (c_type) {
+        case SQL_C_CHAR:
+        case SQL_C_WCHAR:
+            is_parsable = !column_type.empty();
+            break;
 
-                    if (param_info.name.size() == 1)
-                        throw SqlException("Syntax error or access violation", "42000");
+        case SQL_C_DATE:
+        case SQL_C_TYPE_DATE:
+            is_parsable = (type_id == DataSourceTypeId::Date);
+            break;
 
-                    param_info.tmp_placeholder = generate_placeholder();
-                    query.replace(i, param_info.name.size(), param_info.tmp_placeholder);
-                    i += param_info.tmp_placeholder.size() - 1; // - 1 to compensate for's next ++i
-                    parameters.emplace_back(param_info);
-                }
-                break;
-            }
+        default: {
+            // A narrower column type, or one of a different signedness, would make the server reject, or wrap, some of the values,
+            // and an integer column would reject fractional values, so such parameters keep the type of their C type.
+            const auto c_width = getNumericWidth(c_type);
+            const auto column_width = getNumericWidth(type_id);
+            is_parsable = (
+                c_width.bits > 0 &&
+                column_width.bits >= c_width.bits &&
+                column_width.is_signed == c_width.is_signed &&
+                column_width.is_float == c_width.is_float
+            );
+            break;
         }
     }
 
-    // Access the biggest record to [possibly] create all missing ones.
-    if (ipd_record_count < parameters.size())
-        ipd_desc.getRecord(parameters.size(), SQL_ATTR_IMP_PARAM_DESC);
+    if (!is_parsable)
+        return false;
+
+    type = base_type;
+    return true;
 }
 
-std::string Statement::buildFinalQuery(const std::vector<ParamBindingInfo>& param_bindings) {
-    auto prepared_query = query;
+const std::vector<Statement::ParamEncoding> & Statement::getParamEncodings(const std::vector<ParamBindingInfo> & param_bindings) {
+    if (param_encodings_valid && param_encodings.size() == parameters.size())
+        return param_encodings;
+
+    const auto & column_types = getParamColumnTypes();
+
+    param_encodings.clear();
+    param_encodings.reserve(parameters.size());
 
     for (std::size_t i = 0; i < parameters.size(); ++i) {
-        const auto & param_info = parameters[i];
-        std::string param_type;
+        auto & encoding = param_encodings.emplace_back();
+        encoding.name = getParamFinalName(i);
+        encoding.http_name = "param_" + encoding.name;
 
         if (param_bindings.size() <= i) {
-            param_type = "Nullable(Nothing)";
+            encoding.type = "Nullable(Nothing)";
+            encoding.nullable_type = encoding.type;
         }
         else {
             const auto & binding_info = param_bindings[i];
@@ -340,21 +729,57 @@ std::string Statement::buildFinalQuery(const std::vector<ParamBindingInfo>& para
             type_info.value_max_size = binding_info.value_max_size;
             type_info.precision = binding_info.precision;
             type_info.scale = binding_info.scale;
-            type_info.is_nullable = (binding_info.is_nullable || binding_info.value == nullptr);
 
-            param_type = convertSQLOrCTypeToDataSourceType(type_info);
+            type_info.is_nullable = binding_info.is_nullable;
+            encoding.type = convertSQLOrCTypeToDataSourceType(type_info);
+
+            type_info.is_nullable = true;
+            encoding.nullable_type = (binding_info.is_nullable ? encoding.type : convertSQLOrCTypeToDataSourceType(type_info));
+
+            // The type of NULL doesn't matter, but the other values are better parsed as the column type right away, than converted later.
+            if (i < column_types.size() && !column_types[i].empty())
+                tryInferParamType(column_types[i], binding_info.c_type, encoding.type);
+
+            encoding.read = getReadyDataReader<std::string>(binding_info.c_type);
+            encoding.is_bound = true;
         }
+    }
 
-        const auto pos = prepared_query.find(param_info.tmp_placeholder);
-        if (pos == std::string::npos)
-            throw SqlException("COUNT field incorrect", "07002");
+    param_encodings_valid = true;
+    return param_encodings;
+}
 
-        const auto param_name = getParamFinalName(i);
-        const std::string param_placeholder = "{" + param_name + ":" + param_type + "}";
-        prepared_query.replace(pos, param_info.tmp_placeholder.size(), param_placeholder);
+std::string Statement::buildFinalQuery(const std::vector<ParamBindingInfo>& param_bindings) {
+    const auto & encodings = getParamEncodings(param_bindings);
+
+    const auto get_type = [&] (std::size_t i) -> const std::string & {
+        return (encodings[i].is_bound && param_bindings[i].value != nullptr ? encodings[i].type : encodings[i].nullable_type);
+    };
+
+    // Each parameter marker is replaced by a "{name:Type}" substitution, the text between the markers is copied as is.
+    std::size_t final_size = query.size();
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+        final_size += encodings[i].name.size() + get_type(i).size() + 3;
+        final_size -= parameters[i].marker_size;
+    }
+
+    std::string final_query;
+    final_query.reserve(final_size);
+
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+        const auto & param_info = parameters[i];
+        final_query.append(query, pos, param_info.marker_pos - pos);
+        final_query += '{';
+        final_query += encodings[i].name;
+        final_query += ':';
+        final_query += get_type(i);
+        final_query += '}';
+        pos = param_info.marker_pos + param_info.marker_size;
     }
+    final_query.append(query, pos, std::string::npos);
 
-    return prepared_query;
+    return final_query;
 }
 
 void Statement::executeQuery(const std::string & q, std::unique_ptr<ResultMutator> && mutator) {
@@ -402,84 +827,1010 @@ bool Statement::advanceToNextResultSet() {
 
 void Statement::closeCursor() {
     auto & connection = getParent();
+
+    abortDataAtExecution();
+
+    // Stop the decompression worker, if any, before touching the underlying stream.
+    closeResultReader();
+
     if (statement_session && response && in) {
         if (in->fail() || !in->eof())
             statement_session->reset();
     }
 
-    result_reader.reset();
     in = nullptr;
     response.reset();
 
     is_executed = false;
     is_forward_executed = false;
-}
 
-void Statement::resetColBindings() {
-    getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC).setAttr(SQL_DESC_COUNT, 0);
+    // Rows added through the cursor must reach the table before it is closed.
+    finishBulkAdd();
 }
 
-void Statement::resetParamBindings() {
-    getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).setAttr(SQL_DESC_COUNT, 0);
-}
+SQLRETURN Statement::callAsync(SQLUSMALLINT function_id, std::function<SQLRETURN ()> && operation) {
+    if (async_result.valid()) {
+        if (function_id != async_function_id)
+            throw SqlException("Function sequence error", "HY010");
 
-std::string Statement::getParamFinalName(std::size_t param_idx) {
-    auto & ipd_desc = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC);
-    if (param_idx < ipd_desc.getRecordCount()) {
-        auto & ipd_record = ipd_desc.getRecord(param_idx + 1, SQL_ATTR_IMP_PARAM_DESC);
-        if (ipd_record.getAttrAs<SQLSMALLINT>(SQL_DESC_UNNAMED, SQL_UNNAMED) != SQL_UNNAMED)
-            return tryStripParamPrefix(ipd_record.getAttrAs<std::string>(SQL_DESC_NAME));
+        if (async_result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return SQL_STILL_EXECUTING;
+
+        return completeAsync();
     }
 
-    if (param_idx < parameters.size() && !parameters[param_idx].name.empty())
-        return tryStripParamPrefix(parameters[param_idx].name);
+    const auto async_enable = getAttrAs<SQLULEN>(
+        SQL_ATTR_ASYNC_ENABLE,
+        getParent().getAttrAs<SQLULEN>(SQL_ATTR_ASYNC_ENABLE, SQL_ASYNC_ENABLE_OFF)
+    );
 
-    return "odbc_positional_" + std::to_string(param_idx + 1);
-}
+    if (async_enable != SQL_ASYNC_ENABLE_ON)
+        return operation();
 
-std::vector<ParamBindingInfo> Statement::getParamsBindingInfo(std::size_t param_set_idx) {
-    std::vector<ParamBindingInfo> param_bindings;
+    std::lock_guard<std::mutex> lock(async_mutex);
+    cancel_requested = false;
+    async_function_id = function_id;
+    async_result = std::async(std::launch::async, std::move(operation));
 
-    auto & apd_desc = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
-    auto & ipd_desc = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC);
+    return SQL_STILL_EXECUTING;
+}
 
-    const auto apd_record_count = apd_desc.getRecordCount();
-    const auto ipd_record_count = ipd_desc.getRecordCount();
+SQLRETURN Statement::completeAsync() {
+    std::unique_lock<std::mutex> lock(async_mutex);
+    if (!async_result.valid())
+        throw SqlException("Function sequence error", "HY010");
 
-    const auto fully_bound_param_count = std::min(apd_record_count, ipd_record_count);
+    auto result = std::move(async_result);
+    async_function_id = 0;
+    lock.unlock();
 
-    // We allow (apd_record_count < ipd_record_count) here, since we will set
-    // all unbound parameters to 'Null' and their types to 'Nullable(Nothing)'.
+    if (cancel_requested) {
+        cancel_requested = false;
+        result.wait();
+        closeCursor();
+        throw SqlException("Operation canceled", "HY008");
+    }
 
-    if (fully_bound_param_count > 0)
-        param_bindings.reserve(fully_bound_param_count);
+    return result.get(); // Rethrows the exception of the operation, if any.
+}
 
-    auto * array_status_ptr = ipd_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+bool Statement::cancelAsync() {
+    std::lock_guard<std::mutex> lock(async_mutex);
+    if (!async_result.valid())
+        return false;
 
-    const auto bind_type = apd_desc.getAttrAs<SQLULEN>(SQL_DESC_BIND_TYPE, SQL_PARAM_BIND_TYPE_DEFAULT);
-    const auto * bind_offset_ptr = apd_desc.getAttrAs<SQLULEN *>(SQL_DESC_BIND_OFFSET_PTR, 0);
-    const auto bind_offset = (bind_offset_ptr ? *bind_offset_ptr : 0);
+    cancel_requested = true;
+
+    // Wake the operation up if it waits for the server. It fails with an I/O error, which is reported as HY008.
+    try {
+        statement_session->abort();
+    }
+    catch (const Poco::Exception & e) {
+        LOG("Aborting the session of a canceled operation: " << e.displayText()); // E.g., not connected at the moment.
+    }
+
+    return true;
+}
+
+bool Statement::isAsyncInProgress() const {
+    std::lock_guard<std::mutex> lock(async_mutex);
+    return async_result.valid();
+}
+
+// Find the table that a simple "SELECT ... FROM [db.]table [WHERE ...]" query reads from.
+static bool tryExtractTableName(const std::string & query, std::string & table) {
+    const auto is_word = [] (const Token & token) {
+        return (token.type == Token::IDENT || (token.type >= Token::FN && token.type < Token::COMMA));
+    };
+
+    const auto is_keyword = [&] (const Token & token, const char * keyword) {
+        return (is_word(token) && Poco::icompare(token.literal.to_string(), keyword) == 0);
+    };
+
+    Lexer lexer(query);
+    if (!is_keyword(lexer.Consume(), "SELECT"))
+        return false;
+
+    for (int depth = 0;;) {
+        const auto token = lexer.Consume();
+
+        if (token.type == Token::EOS || token.isInvalid())
+            return false;
+        else if (token.type == Token::LPARENT)
+            ++depth;
+        else if (token.type == Token::RPARENT)
+            --depth;
+        else if (depth == 0 && is_keyword(token, "FROM"))
+            break;
+    }
+
+    const auto table_token = lexer.Consume();
+    if (!is_word(table_token))
+        return false;
+
+    // Anything but a plain filter, e.g., a join, a table function or an alias, makes the target ambiguous.
+    const auto next = lexer.Peek();
+    if (
+        next.type != Token::EOS &&
+        !is_keyword(next, "FINAL") &&
+        !is_keyword(next, "SAMPLE") &&
+        !is_keyword(next, "PREWHERE") &&
+        !is_keyword(next, "WHERE") &&
+        !is_keyword(next, "ORDER") &&
+        !is_keyword(next, "LIMIT") &&
+        !is_keyword(next, "SETTINGS") &&
+        !is_keyword(next, "FORMAT")
+    ) {
+        return false;
+    }
+
+    table = table_token.literal.to_string();
+    return true;
+}
+
+// Parse a plain "INSERT INTO [db.]table (column, ...) VALUES (?, ...)" query, with a '?' marker per column.
+static bool tryParseInsertValues(const std::string & query, std::string & table, std::vector<std::string> & columns) {
+    const auto is_word = [] (const Token & token) {
+        return (token.type == Token::IDENT || (token.type >= Token::FN && token.type < Token::COMMA));
+    };
+
+    const auto is_keyword = [&] (const Token & token, const char * keyword) {
+        return (is_word(token) && Poco::icompare(token.literal.to_string(), keyword) == 0);
+    };
+
+    Lexer lexer(query);
+    if (!is_keyword(lexer.Consume(), "INSERT") || !is_keyword(lexer.Consume(), "INTO"))
+        return false;
+
+    if (is_keyword(lexer.Peek(), "TABLE"))
+        lexer.Consume();
+
+    const auto table_token = lexer.Consume();
+    if (!is_word(table_token) || !lexer.Match(Token::LPARENT))
+        return false;
+
+    columns.clear();
+    do {
+        const auto column_token = lexer.Consume();
+        if (!is_word(column_token))
+            return false;
+
+        auto column = column_token.literal.to_string();
+        if (column.size() > 2 && column.front() == '`' && column.back() == '`')
+            column = column.substr(1, column.size() - 2);
+
+        if (column.find_first_of("`.") != std::string::npos)
+            return false;
+
+        columns.push_back(std::move(column));
+    } while (lexer.Match(Token::COMMA));
+
+    if (!lexer.Match(Token::RPARENT) || !is_keyword(lexer.Consume(), "VALUES") || !lexer.Match(Token::LPARENT))
+        return false;
+
+    std::size_t marker_count = 0;
+    do {
+        if (!lexer.Match(Token::PARAM))
+            return false;
+        ++marker_count;
+    } while (lexer.Match(Token::COMMA));
+
+    if (!lexer.Match(Token::RPARENT) || lexer.Peek().type != Token::EOS || marker_count != columns.size())
+        return false;
+
+    table = table_token.literal.to_string();
+    return true;
+}
+
+std::size_t Statement::bulkAdd() {
+    if (!hasResultSet())
+        throw SqlException("Function sequence error", "HY010");
+
+    std::string table;
+    if (!tryExtractTableName(query, table))
+        throw SqlException("Optional feature not implemented: rows can be added only to a result set selected from a single table", "HYC00");
+
+    auto & connection = getParent();
+    auto & result_set = getResultSet();
+    auto & ard_desc = getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC);
+    auto & ird_desc = getEffectiveDescriptor(SQL_ATTR_IMP_ROW_DESC);
+
+    const auto row_set_size = ard_desc.getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
+    const auto * row_operation_ptr = ard_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    auto * array_status_ptr = ird_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+
+    const auto bind_type = ard_desc.getAttrAs<SQLULEN>(SQL_DESC_BIND_TYPE, SQL_BIND_TYPE_DEFAULT);
+    const auto * bind_offset_ptr = ard_desc.getAttrAs<SQLULEN *>(SQL_DESC_BIND_OFFSET_PTR, 0);
+    const auto bind_offset = (bind_offset_ptr ? *bind_offset_ptr : 0);
+
+    // Only the bound columns are inserted, the rest get their default values.
+    std::vector<RowBinaryWriter::Column> columns;
+    std::vector<BindingInfo> base_bindings;
+
+    const auto column_count = std::min<std::size_t>(ard_desc.getRecordCount(), result_set.getColumnCount());
+    for (std::size_t column_num = 1; column_num <= column_count; ++column_num) { // Skipping the bookmark (0) column.
+        auto & ard_record = ard_desc.getRecord(column_num, SQL_ATTR_APP_ROW_DESC);
+
+        BindingInfo base_binding;
+        base_binding.c_type = ard_record.getAttrAs<SQLSMALLINT>(SQL_DESC_CONCISE_TYPE, SQL_C_DEFAULT);
+        base_binding.value = ard_record.getAttrAs<SQLPOINTER>(SQL_DESC_DATA_PTR, 0);
+        base_binding.value_max_size = ard_record.getAttrAs<SQLLEN>(SQL_DESC_OCTET_LENGTH, 0);
+        base_binding.value_size = ard_record.getAttrAs<SQLLEN *>(SQL_DESC_OCTET_LENGTH_PTR, 0);
+        base_binding.indicator = ard_record.getAttrAs<SQLLEN *>(SQL_DESC_INDICATOR_PTR, 0);
+
+        if (!base_binding.value && !base_binding.value_size && !base_binding.indicator)
+            continue;
+
+        const auto & column_info = result_set.getColumnInfo(column_num - 1);
+        columns.push_back(RowBinaryWriter::Column{column_info.name, column_info.type, base_binding.c_type});
+        base_bindings.push_back(base_binding);
+    }
+
+    if (columns.empty())
+        throw SqlException("No columns are bound", "HY000");
+
+    RowBinaryWriter writer(columns);
+    std::string body;
+    std::vector<std::size_t> added_row_indices;
+
+    for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx) {
+        if (row_operation_ptr && row_operation_ptr[row_idx] == SQL_ROW_IGNORE)
+            continue;
+
+        try {
+            for (std::size_t i = 0; i < base_bindings.size(); ++i) {
+                const auto & base_binding = base_bindings[i];
+                auto binding_info = getRowBinding(base_binding, row_idx, bind_type, bind_offset);
+
+                writer.writeValue(i, binding_info, body);
+            }
+        }
+        catch (...) {
+            // The rowset is inserted as a whole, or not at all.
+            if (array_status_ptr)
+                array_status_ptr[row_idx] = SQL_ROW_ERROR;
+            throw;
+        }
+
+        added_row_indices.push_back(row_idx);
+    }
+
+    // Only one rowset is in flight at a time, and its failure must be reported before the next one is accepted.
+    finishBulkAdd();
+
+    // The rows are marked as added only once the previous rowset is known to be inserted,
+    // the outcome of inserting this one is reported by the next call, or by closeCursor().
+    if (array_status_ptr) {
+        for (const auto row_idx : added_row_indices)
+            array_status_ptr[row_idx] = SQL_ROW_ADDED;
+    }
+
+    const auto row_count = added_row_indices.size();
+    if (row_count == 0)
+        return 0;
+
+    auto settings = connection.getRequestSettings();
+    std::string path_and_query = settings.request_template.path_and_query;
+    appendQueryParameter(path_and_query, "query", writer.buildInsertQuery(table));
+
+    const auto query_timeout = getAttrAs<SQLULEN>(SQL_ATTR_QUERY_TIMEOUT, 0);
+    if (query_timeout > 0)
+        appendQueryParameter(path_and_query, "max_execution_time", std::to_string(query_timeout));
+
+    if (!bulk_session)
+        bulk_session = makeSession();
+
+    bulk_session->setTimeout(
+        Poco::Timespan(settings.connection_timeout, 0),
+        Poco::Timespan(settings.timeout, 0),
+        Poco::Timespan(query_timeout > 0 ? query_timeout + 1 : settings.timeout, 0)
+    );
+
+    LOG("Sending " << row_count << " rows (" << body.size() << " bytes) to " << table);
+
+    bulk_add_result = std::async(std::launch::async, [this, settings = std::move(settings), path_and_query = std::move(path_and_query), body = std::move(body), query_timeout] () {
+        sendInsert(*bulk_session, settings, path_and_query, body, query_timeout);
+    });
+
+    return row_count;
+}
+
+void Statement::sendInsert(Poco::Net::HTTPClientSession & session, const Connection::RequestSettings & settings, const std::string & path_and_query, const std::string & body, SQLULEN query_timeout) {
+    Poco::Net::HTTPRequest request;
+    initRequest(request, path_and_query, settings.request_template);
+
+    const auto compression = (body.size() >= min_compressed_request_body_size ? settings.compress_request : CompressionMethod::None);
+    if (compression != CompressionMethod::None)
+        request.set("Content-Encoding", getContentEncoding(compression));
+
+    std::unique_ptr<Poco::Net::HTTPResponse> response;
+    auto & in = sendRequest(session, request, response, false, query_timeout, settings.retry_policy, settings.redirect_limit, [&] (std::ostream & request_stream) {
+        if (compression == CompressionMethod::None) {
+            request_stream.write(body.data(), body.size());
+        }
+        else {
+            CompressingOutputStream compressing_stream(request_stream, compression);
+            compressing_stream.write(body.data(), body.size());
+            compressing_stream.close();
+        }
+    });
+
+    // Read the (empty) response body to the end, so that the connection can be kept alive.
+    in.ignore(std::numeric_limits<std::streamsize>::max());
+}
+
+void Statement::finishBulkAdd() {
+    if (!bulk_add_result.valid())
+        return;
+
+    auto result = std::move(bulk_add_result);
+    result.get(); // Rethrows the failure to insert the rowset, if any.
+}
+
+void Statement::sendInsertBatch(const std::string & path_and_query, const std::string & body, const Connection::RequestSettings & settings) {
+    statement_session->setTimeout(
+        Poco::Timespan(settings.connection_timeout, 0),
+        Poco::Timespan(settings.timeout, 0),
+        Poco::Timespan(settings.timeout, 0)
+    );
+
+    sendInsert(*statement_session, settings, path_and_query, body, 0);
+}
+
+// Find the column a parameter is compared with, as in "column = ?", "t.`column` >= ?", etc., by looking around its marker.
+// Only a bare column compared with a bare parameter is accepted, not operands of other operators, as in "a - b = ?" or "a = ? * 2".
+static std::string findComparedColumn(const std::string & query, std::size_t marker_pos) {
+    static const std::string operator_chars = "=<>!";
+    static const std::array<std::string, 8> operators = {"=", "==", "!=", "<>", "<", ">", "<=", ">="};
+
+    const auto is_word_char = [] (char ch) {
+        return (std::isalnum(static_cast<unsigned char>(ch)) || ch == '_');
+    };
+
+    const auto skip_spaces = [&] (std::size_t pos) {
+        while (pos > 0 && std::isspace(static_cast<unsigned char>(query[pos - 1])))
+            --pos;
+        return pos;
+    };
+
+    // Skip an identifier, bare or quoted with backticks, that ends at pos, and return its beginning, or npos if there is none.
+    const auto skip_identifier = [&] (std::size_t pos) -> std::size_t {
+        if (pos > 0 && query[pos - 1] == '`') {
+            const auto begin = (pos >= 2 ? query.rfind('`', pos - 2) : std::string::npos);
+            if (begin == std::string::npos || begin + 1 >= pos - 1 || query.find('\\', begin) < pos)
+                return std::string::npos;
+            return begin;
+        }
+
+        const auto end = pos;
+        while (pos > 0 && is_word_char(query[pos - 1]))
+            --pos;
+
+        if (pos == end || std::isdigit(static_cast<unsigned char>(query[pos])))
+            return std::string::npos;
+
+        return pos;
+    };
+
+    // What follows the parameter must not bind tighter than the comparison.
+    auto after_marker = marker_pos + 1;
+    if (query[marker_pos] != '?') {
+        while (after_marker < query.size() && is_word_char(query[after_marker]))
+            ++after_marker;
+    }
+
+    while (after_marker < query.size() && std::isspace(static_cast<unsigned char>(query[after_marker])))
+        ++after_marker;
+
+    if (after_marker < query.size() && !is_word_char(query[after_marker]) && query[after_marker] != ')' && query[after_marker] != ',' && query[after_marker] != ';')
+        return {};
+
+    const auto operator_end = skip_spaces(marker_pos);
+    auto pos = operator_end;
+    while (pos > 0 && operator_chars.find(query[pos - 1]) != std::string::npos)
+        --pos;
+
+    if (std::find(operators.begin(), operators.end(), query.substr(pos, operator_end - pos)) == operators.end())
+        return {};
+
+    const auto column_end = skip_spaces(pos);
+    const auto column_begin = skip_identifier(column_end);
+    if (column_begin == std::string::npos)
+        return {};
+
+    // The column may be qualified with a table name or alias.
+    pos = column_begin;
+    if (pos > 0 && query[pos - 1] == '.') {
+        pos = skip_identifier(pos - 1);
+        if (pos == std::string::npos)
+            return {};
+    }
+
+    // What precedes the column must not bind tighter than the comparison, i.e., it must be a keyword (WHERE, AND, etc.), or a delimiter.
+    pos = skip_spaces(pos);
+    if (pos > 0 && !is_word_char(query[pos - 1]) && query[pos - 1] != '(' && query[pos - 1] != ',')
+        return {};
+
+    if (query[column_begin] == '`')
+        return query.substr(column_begin + 1, column_end - column_begin - 2);
+
+    return query.substr(column_begin, column_end - column_begin);
+}
+
+const std::vector<std::string> & Statement::getParamColumnTypes() {
+    if (param_column_types_valid)
+        return param_column_types;
+
+    param_column_types.assign(parameters.size(), std::string{});
+    param_column_types_valid = true;
+
+    auto & connection = getParent();
+    if (!connection.infer_param_types || parameters.empty())
+        return param_column_types;
+
+    // Parameters are mapped to the columns of a single table, either in the list of columns of an INSERT, or in the comparisons of a SELECT.
+    std::string table;
+    std::vector<std::string> columns;
+
+    const bool is_insert = (tryParseInsertValues(query, table, columns) && columns.size() == parameters.size());
+    if (!is_insert) {
+        // Columns compared in subqueries may be of other tables.
+        const auto lowercase_query = Poco::toLower(query);
+        if (!tryExtractTableName(query, table) || lowercase_query.find("select", lowercase_query.find("select") + 6) != std::string::npos)
+            return param_column_types;
+
+        columns.clear();
+        for (const auto & param_info : parameters) {
+            columns.push_back(findComparedColumn(query, param_info.marker_pos));
+        }
+    }
+
+    const auto column_types = connection.getTableColumnTypes(table);
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i].empty())
+            continue;
+
+        const auto it = column_types->find(columns[i]);
+        if (it != column_types->end())
+            param_column_types[i] = it->second;
+    }
+
+    return param_column_types;
+}
+
+bool Statement::tryResolveInsertColumns(std::string & table, std::vector<RowBinaryWriter::Column> & columns) {
+    std::vector<std::string> column_names;
+    if (!tryParseInsertValues(query, table, column_names) || column_names.size() != parameters.size())
+        return false;
+
+    if (!param_layout_valid)
+        resolveParamBindings();
+
+    if (param_layout.params.size() != parameters.size())
+        return false;
+
+    // Unless the types of the target columns are known (see InferParamTypes), the values are sent as text, and converted by the server.
+    const auto & column_types = getParamColumnTypes();
+
+    std::vector<ParamBindingInfo> param_bindings;
+    fillParamsBindingInfo(0, param_bindings);
+
+    columns.clear();
+    for (std::size_t i = 0; i < param_bindings.size(); ++i) {
+        const auto & binding_info = param_bindings[i];
+        if (!isInputParam(binding_info.io_type) || isStreamParam(binding_info.io_type) || isDataAtExecParam(binding_info))
+            return false;
+
+        columns.push_back(RowBinaryWriter::Column{column_names[i], column_types[i], binding_info.c_type});
+    }
+
+    return true;
+}
+
+bool Statement::tryExecuteParallelInsert() {
+    auto & connection = getParent();
+    auto & apd_desc = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
+
+    const auto param_set_array_size = apd_desc.getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
+    if (connection.parallel_insert_threshold == 0 || param_set_array_size < connection.parallel_insert_threshold)
+        return false;
+
+    std::string table;
+    std::vector<RowBinaryWriter::Column> columns;
+    if (!tryResolveInsertColumns(table, columns))
+        return false;
+
+    closeResultReader();
+    abortDataAtExecution();
+
+    getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, 0);
+
+    const RowBinaryWriter writer_template(columns);
+    const auto settings = connection.getRequestSettings();
+
+    std::string path_and_query = settings.request_template.path_and_query;
+    appendQueryParameter(path_and_query, "query", writer_template.buildInsertQuery(table));
+
+    const auto query_timeout = getAttrAs<SQLULEN>(SQL_ATTR_QUERY_TIMEOUT, 0);
+    if (query_timeout > 0)
+        appendQueryParameter(path_and_query, "max_execution_time", std::to_string(query_timeout));
+
+    // Only a few chunks are in memory at a time, one per stream.
+    const std::size_t stream_count = std::min<std::size_t>(connection.parallel_insert_streams, param_set_array_size);
+    const std::size_t chunk_size = std::min<std::size_t>((param_set_array_size + stream_count - 1) / stream_count, max_parallel_insert_chunk_size);
+    const std::size_t chunk_count = (param_set_array_size + chunk_size - 1) / chunk_size;
+
+    while (upload_sessions.size() < stream_count)
+        upload_sessions.push_back(makeSession());
+
+    for (std::size_t i = 0; i < stream_count; ++i) {
+        upload_sessions[i]->setTimeout(
+            Poco::Timespan(connection.getConnectionTimeout(), 0),
+            Poco::Timespan(connection.getTimeout(), 0),
+            Poco::Timespan(query_timeout > 0 ? query_timeout + 1 : connection.getTimeout(), 0)
+        );
+    }
+
+    const auto * operation_ptr = apd_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    auto * status_ptr = param_layout.array_status_ptr;
+
+    // The parameter sets of the chunks that are not taken before the execution is canceled are not processed.
+    if (status_ptr) {
+        for (std::size_t idx = 0; idx < param_set_array_size; ++idx)
+            status_ptr[idx] = SQL_PARAM_UNUSED;
+    }
+
+    std::atomic_size_t next_chunk_idx = 0;
+    std::atomic_size_t processed_param_set_count = 0;
+    std::atomic_size_t inserted_row_count = 0;
+    std::atomic_size_t failed_chunk_count = 0;
+    std::exception_ptr first_failure;
+    std::mutex first_failure_mutex;
+
+    // Each stream takes the next chunk, serializes it, and sends it, until there are no chunks left. A chunk is inserted as a whole, or not at all.
+    const auto upload = [&] (Poco::Net::HTTPClientSession & session) {
+        auto writer = writer_template;
+        std::vector<ParamBindingInfo> bindings;
+        std::string body;
+
+        for (std::size_t chunk_idx = next_chunk_idx++; chunk_idx < chunk_count && !cancel_requested; chunk_idx = next_chunk_idx++) {
+            const auto begin = chunk_idx * chunk_size;
+            const auto end = std::min<std::size_t>(begin + chunk_size, param_set_array_size);
+            std::size_t row_count = 0;
+
+            processed_param_set_count += end - begin;
+
+            const auto set_status = [&] (SQLUSMALLINT status) {
+                if (status_ptr) {
+                    for (auto idx = begin; idx < end; ++idx)
+                        status_ptr[idx] = (operation_ptr && operation_ptr[idx] == SQL_PARAM_IGNORE ? SQL_PARAM_UNUSED : status);
+                }
+            };
+
+            try {
+                body.clear();
+
+                for (auto idx = begin; idx < end; ++idx) {
+                    if (operation_ptr && operation_ptr[idx] == SQL_PARAM_IGNORE)
+                        continue;
+
+                    fillParamsBindingInfo(idx, bindings);
+                    for (std::size_t i = 0; i < bindings.size(); ++i) {
+                        writer.writeValue(i, bindings[i], body);
+                    }
+
+                    ++row_count;
+                }
+
+                if (row_count > 0)
+                    sendInsert(session, settings, path_and_query, body, query_timeout);
+
+                set_status(SQL_PARAM_SUCCESS);
+                inserted_row_count += row_count;
+            }
+            catch (...) {
+                set_status(SQL_PARAM_ERROR);
+                ++failed_chunk_count;
+
+                std::lock_guard<std::mutex> lock(first_failure_mutex);
+                if (!first_failure)
+                    first_failure = std::current_exception();
+            }
+        }
+    };
+
+    LOG("Inserting " << param_set_array_size << " parameter sets into " << table << " in " << chunk_count << " chunks over " << stream_count << " streams");
+
+    std::vector<std::future<void>> streams;
+    try {
+        for (std::size_t i = 1; i < stream_count; ++i) {
+            streams.push_back(std::async(std::launch::async, upload, std::ref(*upload_sessions[i])));
+        }
+    }
+    catch (const std::system_error & e) {
+        LOG("Failed to start an insert stream, continuing with " << streams.size() + 1 << ": " << e.what());
+    }
+
+    upload(*upload_sessions[0]);
+
+    for (auto & stream : streams) {
+        stream.get();
+    }
+
+    auto * param_set_processed_ptr = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).getAttrAs<SQLULEN *>(SQL_DESC_ROWS_PROCESSED_PTR, 0);
+    if (param_set_processed_ptr)
+        *param_set_processed_ptr = processed_param_set_count.load();
+
+    next_param_set_idx = param_set_array_size;
+    getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, inserted_row_count.load());
+
+    if (cancel_requested)
+        throw SqlException("Operation canceled", "HY008");
+
+    if (first_failure) {
+        LOG(failed_chunk_count.load() << " of " << chunk_count << " chunks failed to be inserted into " << table);
+        std::rethrow_exception(first_failure);
+    }
+
+    return true;
+}
+
+bool Statement::tryBufferInsert() {
+    auto & connection = getParent();
+    if (connection.buffered_insert_max_rows == 0)
+        return false;
+
+    std::string table;
+    std::vector<RowBinaryWriter::Column> columns;
+    if (!tryResolveInsertColumns(table, columns))
+        return false;
+
+    closeResultReader();
+    abortDataAtExecution();
+
+    getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, 0);
+
+    auto & apd_desc = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
+    const auto param_set_array_size = apd_desc.getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
+    const auto * operation_ptr = apd_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    auto * status_ptr = param_layout.array_status_ptr;
+
+    const auto set_status = [&] (SQLUSMALLINT status) {
+        if (status_ptr) {
+            for (std::size_t idx = 0; idx < param_set_array_size; ++idx)
+                status_ptr[idx] = (operation_ptr && operation_ptr[idx] == SQL_PARAM_IGNORE ? SQL_PARAM_UNUSED : status);
+        }
+    };
+
+    RowBinaryWriter writer(columns);
+    std::vector<ParamBindingInfo> bindings;
+    std::string rows;
+    std::size_t row_count = 0;
+
+    // The parameter sets of an execution are buffered all, or none of them.
+    for (std::size_t idx = 0; idx < param_set_array_size; ++idx) {
+        if (operation_ptr && operation_ptr[idx] == SQL_PARAM_IGNORE)
+            continue;
+
+        try {
+            fillParamsBindingInfo(idx, bindings);
+            for (std::size_t i = 0; i < bindings.size(); ++i) {
+                writer.writeValue(i, bindings[i], rows);
+            }
+        }
+        catch (...) {
+            set_status(SQL_PARAM_UNUSED);
+            if (status_ptr)
+                status_ptr[idx] = SQL_PARAM_ERROR;
+            throw;
+        }
+
+        ++row_count;
+    }
+
+    if (row_count > 0) {
+        std::string path_and_query = connection.getRequestTemplate().path_and_query;
+        appendQueryParameter(path_and_query, "query", writer.buildInsertQuery(table));
+
+        try {
+            connection.bufferInsert(path_and_query, rows, row_count);
+        }
+        catch (...) {
+            set_status(SQL_PARAM_ERROR);
+            throw;
+        }
+    }
+
+    set_status(SQL_PARAM_SUCCESS);
+
+    auto * param_set_processed_ptr = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).getAttrAs<SQLULEN *>(SQL_DESC_ROWS_PROCESSED_PTR, 0);
+    if (param_set_processed_ptr)
+        *param_set_processed_ptr = param_set_array_size;
+
+    next_param_set_idx = param_set_array_size;
+    getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, row_count);
+
+    return true;
+}
+
+bool Statement::needsData() const {
+    return (data_at_execution != nullptr);
+}
+
+void Statement::startDataAtExecution() {
+    auto & connection = getParent();
+    auto & dae = *data_at_execution;
+
+    // The values are streamed only once, so the request can't be retried, or redirected, once it is sent.
+    dae.host_idx = connection.hosts.pick();
+    const auto endpoint = connection.hosts.getEndpoint(dae.host_idx);
+
+    if (connection.hosts.size() > 1 && !CircuitBreaker::forEndpoint(endpoint.host, endpoint.port).allowRequest())
+        throw std::runtime_error("Too many recent failures of requests to " + endpoint.host + ":" + std::to_string(endpoint.port) + ", not sending requests to it for a while");
+
+    if (statement_session->getHost() != endpoint.host || statement_session->getPort() != endpoint.port) {
+        statement_session->reset();
+        statement_session->setHost(endpoint.host);
+        statement_session->setPort(endpoint.port);
+    }
+
+    if (!isIdleConnectionAlive(*statement_session))
+        statement_session->reset();
+
+    dae.multipart_boundary = Poco::Net::MultipartWriter::createBoundary();
+    dae.request = std::make_unique<Poco::Net::HTTPRequest>();
+    initRequest(*dae.request, dae.path_and_query);
+    dae.request->setHost(endpoint.host);
+    dae.request->setContentType("multipart/form-data; boundary=" + dae.multipart_boundary);
+
+    LOG(dae.request->getMethod() << " " << dae.request->getURI() << " body=" << dae.query << " (with data-at-execution parameters)"
+                                 << " UA=" << dae.request->get("User-Agent"));
+
+    in = nullptr; // The stream of the previous response, if any, is destroyed by the next request.
+    response.reset();
+
+    dae.started_at = HostPool::Clock::now();
+    dae.request_stream = &statement_session->sendRequest(*dae.request);
+    writeMultipartHttpRequest(*dae.request_stream, dae.multipart_boundary, dae.query, dae.param_bindings, false);
+}
+
+SQLRETURN Statement::nextDataAtExecParam(SQLPOINTER * value) {
+    if (!data_at_execution)
+        throw SqlException("Function sequence error", "HY010");
+
+    auto & connection = getParent();
+    auto & dae = *data_at_execution;
+    bool request_sent = false;
+
+    try {
+        if (dae.current == 0)
+            startDataAtExecution();
+        else
+            *dae.request_stream << "\r\n"; // Finish the value of the previous parameter.
+
+        if (dae.current < dae.param_indices.size()) {
+            const auto param_idx = dae.param_indices[dae.current++];
+            dae.current_has_data = false;
+            dae.current_is_null = false;
+            writeMultipartPartHeader(*dae.request_stream, dae.multipart_boundary, getParamEncodings(dae.param_bindings)[param_idx].http_name);
+
+            if (value)
+                *value = dae.param_bindings[param_idx].value;
+
+            return SQL_NEED_DATA;
+        }
+
+        *dae.request_stream << "--" << dae.multipart_boundary << "--\r\n";
+        request_sent = true;
+        response = std::make_unique<Poco::Net::HTTPResponse>();
+        in = &statement_session->receiveResponse(*response);
+    }
+    catch (const Poco::Exception & e) {
+        const bool timeout = (dynamic_cast<const Poco::TimeoutException *>(&e) != nullptr);
+        if (!timeout && dynamic_cast<const Poco::IOException *>(&e) == nullptr) {
+            abortDataAtExecution();
+            throw;
+        }
+
+        RequestFailure failure;
+        failure.timeout = timeout;
+        failure.request_sent = request_sent;
+
+        // The values have been consumed, so the request is never sent again, whatever the action is.
+        const auto action = connection.getRetryPolicy().getFailureAction(1, failure, false, dae.query_timeout > 0);
+        const auto endpoint = connection.hosts.getEndpoint(dae.host_idx);
+
+        if (action == FailureAction::QueryTimeout) {
+            LOG("Http request to " << endpoint.host << ":" << endpoint.port << " timed out: " << e.message());
+            abortDataAtExecution();
+            throw SqlException("Query timeout expired", "HYT00");
+        }
+
+        connection.hosts.reportFailure(dae.host_idx);
+        CircuitBreaker::forEndpoint(endpoint.host, endpoint.port).reportFailure();
+        LOG("Http request to " << endpoint.host << ":" << endpoint.port << " failed: " << e.what() << ": " << e.message());
+
+        abortDataAtExecution();
+        throw;
+    }
+    catch (...) {
+        abortDataAtExecution();
+        throw;
+    }
+
+    // The values have been consumed, so a rejected request is not sent again either.
+    const auto endpoint = connection.hosts.getEndpoint(dae.host_idx);
+    const auto response_action = connection.getRetryPolicy().getResponseAction(1, response->getStatus());
+
+    if (response_action.endpoint_failed) {
+        connection.hosts.reportFailure(dae.host_idx);
+        if (response_action.trip_breaker)
+            CircuitBreaker::forEndpoint(endpoint.host, endpoint.port).reportFailure();
+    }
+    else {
+        connection.hosts.reportSuccess(dae.host_idx, HostPool::Clock::now() - dae.started_at);
+        CircuitBreaker::forEndpoint(endpoint.host, endpoint.port).reportSuccess();
+    }
+
+    auto mutator = std::move(dae.mutator);
+    const auto query_timeout = dae.query_timeout;
+    data_at_execution.reset();
+
+    throwOnErrorResponse(*response, *in, connection.redirect_limit, query_timeout);
+    receiveResultSets(std::move(mutator));
+
+    return SQL_SUCCESS;
+}
+
+void Statement::putData(SQLPOINTER data, SQLLEN size) {
+    if (!data_at_execution || data_at_execution->current == 0)
+        throw SqlException("Function sequence error", "HY010");
+
+    auto & dae = *data_at_execution;
+    const auto & binding_info = dae.param_bindings[dae.param_indices[dae.current - 1]];
+
+    if (dae.current_is_null || (size == SQL_NULL_DATA && dae.current_has_data))
+        throw SqlException("Attempt to concatenate a null value", "HY020");
+
+    const bool is_char_or_binary = (
+        binding_info.c_type == SQL_C_CHAR ||
+        binding_info.c_type == SQL_C_WCHAR ||
+        binding_info.c_type == SQL_C_BINARY
+    );
+
+    if (dae.current_has_data && !is_char_or_binary)
+        throw SqlException("Non-character and non-binary data sent in pieces", "HY019");
+
+    if (size != SQL_NULL_DATA && data == nullptr)
+        throw SqlException("Invalid use of null pointer", "HY009");
+
+    try {
+        if (size == SQL_NULL_DATA) {
+            *dae.request_stream << "\\N";
+            dae.current_is_null = true;
+        }
+        else if (binding_info.c_type == SQL_C_CHAR || binding_info.c_type == SQL_C_BINARY) {
+            if (size == SQL_NTS && binding_info.c_type == SQL_C_CHAR)
+                size = std::strlen(static_cast<const char *>(data));
+
+            if (size < 0)
+                throw SqlException("Invalid string or buffer length", "HY090");
+
+            // Written straight into the chunked request body, without being buffered as a whole.
+            dae.request_stream->write(static_cast<const char *>(data), size);
+        }
+        else {
+            BindingInfo chunk_binding_info;
+            chunk_binding_info.c_type = binding_info.c_type;
+            chunk_binding_info.value = data;
+            chunk_binding_info.value_max_size = (size < 0 ? 0 : size);
+            chunk_binding_info.value_size = (binding_info.c_type == SQL_C_WCHAR ? &size : nullptr);
+            chunk_binding_info.precision = binding_info.precision;
+            chunk_binding_info.scale = binding_info.scale;
+
+            std::string value;
+            readReadyDataTo(chunk_binding_info, value);
+            dae.request_stream->write(value.data(), value.size());
+        }
+    }
+    catch (const Poco::Exception &) {
+        auto & connection = getParent();
+        connection.hosts.reportFailure(dae.host_idx);
+        abortDataAtExecution();
+        throw;
+    }
+
+    dae.current_has_data = true;
+}
+
+void Statement::abortDataAtExecution() {
+    if (!data_at_execution)
+        return;
+
+    // The request has been sent partially, so the connection is unusable.
+    if (data_at_execution->request_stream)
+        statement_session->reset();
+
+    data_at_execution.reset();
+}
+
+void Statement::closeResultReader() {
+    result_reader.reset();
+
+    if (!decompressed_in)
+        return;
+
+    // The prefetch worker may be blocked on the socket, waiting for the rest of an abandoned result,
+    // and the decompressor can't be destroyed until it returns.
+    if (!decompressed_in->isFinished() && statement_session)
+        statement_session->abort();
+
+    decompressed_in.reset();
+}
+
+void Statement::resetColBindings() {
+    getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC).setAttr(SQL_DESC_COUNT, 0);
+}
+
+void Statement::resetParamBindings() {
+    getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).setAttr(SQL_DESC_COUNT, 0);
+}
+
+std::string Statement::getParamFinalName(std::size_t param_idx) {
+    auto & ipd_desc = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC);
+    if (param_idx < ipd_desc.getRecordCount()) {
+        auto & ipd_record = ipd_desc.getRecord(param_idx + 1, SQL_ATTR_IMP_PARAM_DESC);
+        if (ipd_record.getAttrAs<SQLSMALLINT>(SQL_DESC_UNNAMED, SQL_UNNAMED) != SQL_UNNAMED)
+            return tryStripParamPrefix(ipd_record.getAttrAs<std::string>(SQL_DESC_NAME));
+    }
+
+    if (param_idx < parameters.size() && !parameters[param_idx].name.empty())
+        return tryStripParamPrefix(parameters[param_idx].name);
+
+    return "odbc_positional_" + std::to_string(param_idx + 1);
+}
+
+void Statement::resolveParamBindings() {
+    param_layout = ParamBindingLayout{};
+
+    auto & apd_desc = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
+    auto & ipd_desc = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC);
+
+    const auto apd_record_count = apd_desc.getRecordCount();
+    const auto ipd_record_count = ipd_desc.getRecordCount();
+
+    const auto fully_bound_param_count = std::min(apd_record_count, ipd_record_count);
+
+    // We allow (apd_record_count < ipd_record_count) here, since we will set
+    // all unbound parameters to 'Null' and their types to 'Nullable(Nothing)'.
+
+    if (fully_bound_param_count > 0)
+        param_layout.params.reserve(fully_bound_param_count);
+
+    param_layout.array_status_ptr = ipd_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    param_layout.bind_offset_ptr = apd_desc.getAttrAs<SQLULEN *>(SQL_DESC_BIND_OFFSET_PTR, 0);
+
+    const auto bind_type = apd_desc.getAttrAs<SQLULEN>(SQL_DESC_BIND_TYPE, SQL_PARAM_BIND_TYPE_DEFAULT);
 
     for (std::size_t param_num = 1; param_num <= fully_bound_param_count; ++param_num) {
         auto & apd_record = apd_desc.getRecord(param_num, SQL_ATTR_APP_PARAM_DESC);
         auto & ipd_record = ipd_desc.getRecord(param_num, SQL_ATTR_IMP_PARAM_DESC);
 
-        const auto * data_ptr = apd_record.getAttrAs<SQLPOINTER>(SQL_DESC_DATA_PTR, 0);
-        const auto * sz_ptr = apd_record.getAttrAs<SQLLEN *>(SQL_DESC_OCTET_LENGTH_PTR, 0);
-        const auto * ind_ptr = apd_record.getAttrAs<SQLLEN *>(SQL_DESC_INDICATOR_PTR, 0);
+        auto & param = param_layout.params.emplace_back();
+        auto & binding_info = param.binding_info;
+
+        binding_info.value = apd_record.getAttrAs<SQLPOINTER>(SQL_DESC_DATA_PTR, 0);
+        binding_info.value_size = apd_record.getAttrAs<SQLLEN *>(SQL_DESC_OCTET_LENGTH_PTR, 0);
+        binding_info.indicator = apd_record.getAttrAs<SQLLEN *>(SQL_DESC_INDICATOR_PTR, 0);
 
-        ParamBindingInfo binding_info;
         binding_info.io_type = ipd_record.getAttrAs<SQLSMALLINT>(SQL_DESC_PARAMETER_TYPE, SQL_PARAM_INPUT);
         binding_info.c_type = apd_record.getAttrAs<SQLSMALLINT>(SQL_DESC_CONCISE_TYPE, SQL_C_DEFAULT);
         binding_info.sql_type = ipd_record.getAttrAs<SQLSMALLINT>(SQL_DESC_CONCISE_TYPE, SQL_UNKNOWN_TYPE);
         binding_info.value_max_size = apd_record.getAttrAs<SQLLEN>(SQL_DESC_OCTET_LENGTH, 0);
 
-        const auto next_value_ptr_increment = (bind_type == SQL_PARAM_BIND_BY_COLUMN ? binding_info.value_max_size : bind_type);
-        const auto next_sz_ind_ptr_increment = (bind_type == SQL_PARAM_BIND_BY_COLUMN ? sizeof(SQLLEN) : bind_type);
-
-        binding_info.value = (SQLPOINTER)(data_ptr ? ((char *)(data_ptr) + param_set_idx * next_value_ptr_increment + bind_offset) : 0);
-        binding_info.value_size = (SQLLEN *)(sz_ptr ? ((char *)(sz_ptr) + param_set_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
-        binding_info.indicator = (SQLLEN *)(ind_ptr ? ((char *)(ind_ptr) + param_set_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
+        // Column-wise, each buffer is an array of its own elements. Row-wise, all the buffers advance by the size of the row structure.
+        param.value_stride = (bind_type == SQL_PARAM_BIND_BY_COLUMN ? static_cast<std::size_t>(binding_info.value_max_size) : bind_type);
+        param.length_stride = (bind_type == SQL_PARAM_BIND_BY_COLUMN ? sizeof(SQLLEN) : bind_type);
 
         // TODO: always use SQL_NULLABLE as a default when https://github.com/ClickHouse/ClickHouse/issues/7488 is fixed.
         binding_info.is_nullable = (
@@ -492,16 +1843,42 @@ std::vector<ParamBindingInfo> Statement::getParamsBindingInfo(std::size_t param_
         binding_info.precision = ipd_record.getAttrAs<SQLSMALLINT>(SQL_DESC_PRECISION,
             (binding_info.sql_type == SQL_DECIMAL || binding_info.sql_type == SQL_NUMERIC ? 38 : 0)
         );
-
-        param_bindings.emplace_back(binding_info);
     }
 
-    if (array_status_ptr)
-        array_status_ptr[param_set_idx] = SQL_PARAM_SUCCESS; // TODO: elaborate?
+    param_layout_valid = true;
+}
+
+std::vector<ParamBindingInfo> Statement::getParamsBindingInfo(std::size_t param_set_idx) {
+    if (!param_layout_valid)
+        resolveParamBindings();
+
+    std::vector<ParamBindingInfo> param_bindings;
+    fillParamsBindingInfo(param_set_idx, param_bindings);
+
+    if (param_layout.array_status_ptr)
+        param_layout.array_status_ptr[param_set_idx] = SQL_PARAM_SUCCESS; // TODO: elaborate?
 
     return param_bindings;
 }
 
+void Statement::fillParamsBindingInfo(std::size_t param_set_idx, std::vector<ParamBindingInfo> & param_bindings) const {
+    const auto bind_offset = (param_layout.bind_offset_ptr ? *param_layout.bind_offset_ptr : 0);
+
+    const auto shift = [] (auto * ptr, std::size_t offset) {
+        return (ptr ? reinterpret_cast<decltype(ptr)>(reinterpret_cast<char *>(ptr) + offset) : nullptr);
+    };
+
+    param_bindings.clear();
+    param_bindings.reserve(param_layout.params.size());
+
+    for (const auto & param : param_layout.params) {
+        auto & binding_info = param_bindings.emplace_back(param.binding_info);
+        binding_info.value = shift(binding_info.value, param_set_idx * param.value_stride + bind_offset);
+        binding_info.value_size = shift(binding_info.value_size, param_set_idx * param.length_stride + bind_offset);
+        binding_info.indicator = shift(binding_info.indicator, param_set_idx * param.length_stride + bind_offset);
+    }
+}
+
 Descriptor& Statement::getEffectiveDescriptor(SQLINTEGER type) {
     switch (type) {
         case SQL_ATTR_APP_ROW_DESC:   return choose(implicit_ard, explicit_ard);
@@ -4,11 +4,18 @@
 #include "driver/connection.h"
 #include "driver/descriptor.h"
 #include "driver/result_set.h"
+#include "driver/format/RowBinaryWriter.h"
+#include "driver/utils/compression.h"
 
+#include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPResponse.h>
 #include <Poco/Net/HTTPClientSession.h>
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -69,6 +76,49 @@ public:
     /// Make an implicit descriptor active again.
     void setImplicitDescriptor(SQLINTEGER type);
 
+    /// Run the operation of an ODBC function (identified by function_id) synchronously, or, if SQL_ATTR_ASYNC_ENABLE is on,
+    /// on a worker thread, returning SQL_STILL_EXECUTING until it completes. Repeated calls of the same function poll
+    /// the operation started by the first call (their own operation is ignored), and the final one returns its result.
+    SQLRETURN callAsync(SQLUSMALLINT function_id, std::function<SQLRETURN ()> && operation);
+
+    /// Wait for the asynchronous operation in progress, and return its result.
+    SQLRETURN completeAsync();
+
+    /// Request cancellation of the asynchronous operation in progress, if any. Returns false if there is none.
+    /// The connection of the statement is aborted, so that the operation doesn't wait for the server, and it completes with HY008.
+    /// May be called from any thread.
+    bool cancelAsync();
+
+    /// Whether an asynchronous operation has been started, and its result hasn't been returned yet.
+    bool isAsyncInProgress() const;
+
+    /// Whether the execution in progress waits for the values of data-at-execution parameters (SQL_NEED_DATA).
+    bool needsData() const;
+
+    /// Finish the value of the current data-at-execution parameter, if any, and move to the next one (SQLParamData).
+    /// Returns SQL_NEED_DATA and the value that identifies the parameter, or, after the last one, completes the execution.
+    SQLRETURN nextDataAtExecParam(SQLPOINTER * value);
+
+    /// Stream a piece of the value of the current data-at-execution parameter into the request body (SQLPutData).
+    void putData(SQLPOINTER data, SQLLEN size);
+
+    /// Insert the rows of the bound rowset into the table the current result set is selected from (SQLBulkOperations(SQL_ADD)).
+    /// The rowset is serialized right away, so the buffers may be refilled as soon as this returns, and is sent in the background,
+    /// while the application prepares the next one. A rowset's outcome is reported by the next SQLBulkOperations call,
+    /// or by SQLCloseCursor (closeCursor()), so SQL_ROW_ADDED in the row status array means that the rows are serialized
+    /// and the previous rowset is inserted. Returns the number of rows sent.
+    std::size_t bulkAdd();
+
+    /// Wait until the rowset sent by bulkAdd(), if any, is inserted, and rethrow the failure to insert it, if any.
+    void finishBulkAdd();
+
+    /// Send a batch of rows buffered by the connection (see Connection::bufferInsert()), and wait until it is inserted.
+    void sendInsertBatch(const std::string & path_and_query, const std::string & body, const Connection::RequestSettings & settings);
+
+    /// Types of the table columns the parameters are inserted into, or compared with, if InferParamTypes is on. A type is empty,
+    /// if not known. Resolved once per prepared query.
+    const std::vector<std::string> & getParamColumnTypes();
+
 public:
     // public only for the unit tests
     struct HttpRequestData {
@@ -77,14 +127,106 @@ public:
     };
     HttpRequestData prepareHttpRequest();
 
+    // Write the final query and the values of the current parameter set as a multipart/form-data request body.
+    void writeMultipartHttpRequest(std::ostream & out, const std::string & boundary);
+
 private:
+    std::unique_ptr<Poco::Net::HTTPClientSession> makeSession();
+
     void requestNextPackOfResultSets(std::unique_ptr<ResultMutator> && mutator);
 
-    void processEscapeSequences();
-    void extractParametersinfo();
+    // Send the request to the best healthy replica, retrying and failing over as far as the retry policy allows, and receive the response.
+    // The body is written by the callback, again for each attempt. Throws if the final response is not 200 OK. With a single replica,
+    // whose circuit breaker is open, the request is sent once, without retries.
+    std::istream & sendRequest(
+        Poco::Net::HTTPClientSession & session,
+        Poco::Net::HTTPRequest & request,
+        std::unique_ptr<Poco::Net::HTTPResponse> & response,
+        bool idempotent,
+        SQLULEN query_timeout,
+        RetryPolicy retry_policy,
+        int redirect_limit,
+        const std::function<void (std::ostream &)> & write_body
+    );
+
+    // Wait before the next attempt to send a request, checking for cancellation every few milliseconds. Throws HY008 if canceled.
+    void sleepBeforeRetry(RetryPolicy::Clock::duration delay);
+
+    // Send a body in the format of the INSERT query in path_and_query, and wait until it is inserted.
+    // The settings are passed by the caller, since this may run in the background, while the connection attributes change.
+    void sendInsert(Poco::Net::HTTPClientSession & session, const Connection::RequestSettings & settings, const std::string & path_and_query, const std::string & body, SQLULEN query_timeout);
+
+    // If the prepared query is "INSERT INTO table (columns) VALUES (?, ...)", with all the parameters bound as plain input values,
+    // get the table, and the columns the parameters are inserted into. Returns false, if not applicable.
+    bool tryResolveInsertColumns(std::string & table, std::vector<RowBinaryWriter::Column> & columns);
+
+    // If the prepared query is "INSERT INTO table (columns) VALUES (?, ...)" and the array of parameters is large enough (see ParallelInsertThreshold),
+    // insert all the parameter sets at once, in RowBinary chunks sent over several sessions in parallel. Returns false, if not applicable.
+    bool tryExecuteParallelInsert();
+
+    // If the prepared query is "INSERT INTO table (columns) VALUES (?, ...)" and buffering is enabled (see BufferedInsertMaxRows),
+    // serialize the parameter sets and append them to the batch of the connection, which is sent later. Returns false, if not applicable.
+    bool tryBufferInsert();
+
+    // Upper limit for the number of parameter sets in a chunk of a parallel insert.
+    static constexpr std::size_t max_parallel_insert_chunk_size = 1 << 17;
+
+    // Convert values of the parameters to their text representation and pass them to the callback, one by one, as (name, value) pairs.
+    // The value buffer is reused between the calls, so the callback must not retain references to it.
+    template <typename Callback>
+    void forEachParamValue(const std::vector<ParamBindingInfo> & param_bindings, Callback && callback);
+
+    // If finish is false, the closing delimiter is not written, so that more parts may follow.
+    void writeMultipartHttpRequest(std::ostream & out, const std::string & boundary, const std::string & query, const std::vector<ParamBindingInfo> & param_bindings, bool finish = true);
+
+    void initRequest(Poco::Net::HTTPRequest & request, const std::string & path_and_query);
+    void initRequest(Poco::Net::HTTPRequest & request, const std::string & path_and_query, const Connection::RequestTemplate & request_template);
+
+    // Start reading the result sets of the response that has just been received.
+    void receiveResultSets(std::unique_ptr<ResultMutator> && mutator);
+
+    // Send the request of the execution that waits for data, with everything but the values of data-at-execution parameters.
+    void startDataAtExecution();
+    void abortDataAtExecution();
+
+    // Destroy the result reader and the decompressor, if any, aborting the session first if the decompressor may still be reading it.
+    void closeResultReader();
+
+    void resetParamDescriptors();
+
+    // Parts of the request that depend on how a parameter is bound, but not on its value.
+    struct ParamEncoding {
+        std::string name;          // Final name, as in {name:Type} substitution.
+        std::string http_name;     // Name of the HTTP parameter (or form field) that carries the value.
+        std::string type;          // Type of the substitution.
+        std::string nullable_type; // Type of the substitution, if the value pointer is null.
+        void (*read)(const BindingInfo & src, std::string & dest) = nullptr; // Text conversion, null if the C type is not supported.
+        bool is_bound = false;
+    };
+
+    // Resolve the encodings of the parameters, once per execution, and reuse them for all the parameter sets of it.
+    const std::vector<ParamEncoding> & getParamEncodings(const std::vector<ParamBindingInfo> & param_bindings);
+
     std::string buildFinalQuery(const std::vector<ParamBindingInfo>& param_bindings);
     std::string getParamFinalName(std::size_t param_idx);
+
+    // Bindings of the parameters, resolved from APD and IPD once per execution. The buffers of any parameter set
+    // are then found by pointer arithmetic, for both column-wise and row-wise binding.
+    struct ParamBindingLayout {
+        struct Param {
+            ParamBindingInfo binding_info; // Of the first parameter set, without the bind offset.
+            std::size_t value_stride = 0;
+            std::size_t length_stride = 0; // Of the octet length and indicator buffers.
+        };
+
+        std::vector<Param> params;
+        const SQLULEN * bind_offset_ptr = nullptr;
+        SQLUSMALLINT * array_status_ptr = nullptr;
+    };
+
+    void resolveParamBindings();
     std::vector<ParamBindingInfo> getParamsBindingInfo(std::size_t param_set_idx);
+    void fillParamsBindingInfo(std::size_t param_set_idx, std::vector<ParamBindingInfo> & param_bindings) const;
 
     Descriptor & choose(std::shared_ptr<Descriptor> & implicit_desc, std::weak_ptr<Descriptor> & explicit_desc);
 
@@ -110,12 +252,53 @@ private:
     bool is_executed = false;
     std::string query;
     std::vector<ParamInfo> parameters;
+    std::vector<ParamEncoding> param_encodings;
+    bool param_encodings_valid = false;
+    ParamBindingLayout param_layout;
+    bool param_layout_valid = false;
+    std::vector<std::string> param_column_types;
+    bool param_column_types_valid = false;
 
     // Independent HTTP session for each statement to avoid concurrent access issues
     std::unique_ptr<Poco::Net::HTTPClientSession> statement_session;
     
     std::unique_ptr<Poco::Net::HTTPResponse> response;
     std::istream* in = nullptr;
+    std::unique_ptr<CompressedBlockInputStream> decompressed_in; // Wraps 'in' when the result is received in compressed blocks.
     std::unique_ptr<ResultReader> result_reader;
     std::size_t next_param_set_idx = 0;
+
+    // Execution that waits for the values of data-at-execution parameters. The request is sent when the first value is requested,
+    // and the values are streamed into its body, as multipart/form-data parts, while they are being put by the application.
+    struct DataAtExecution {
+        std::string path_and_query;
+        std::string query;
+        std::string multipart_boundary;
+        std::vector<ParamBindingInfo> param_bindings;
+        std::vector<std::size_t> param_indices; // Data-at-execution parameters, in the order their values are requested.
+        std::size_t current = 0; // Number of the parameters whose values have been requested so far, the last one is being put.
+        bool current_has_data = false;
+        bool current_is_null = false;
+        SQLULEN query_timeout = 0;
+        std::unique_ptr<ResultMutator> mutator;
+        std::unique_ptr<Poco::Net::HTTPRequest> request;
+        std::ostream * request_stream = nullptr;
+        std::size_t host_idx = 0;
+        HostPool::Clock::time_point started_at;
+    };
+    std::unique_ptr<DataAtExecution> data_at_execution;
+
+    // Rowset of a bulk insert that is being sent in the background, over its own session.
+    std::unique_ptr<Poco::Net::HTTPClientSession> bulk_session;
+    std::future<void> bulk_add_result;
+
+    // Sessions of parallel inserts, kept between executions.
+    std::vector<std::unique_ptr<Poco::Net::HTTPClientSession>> upload_sessions;
+
+    // Asynchronous operation in progress, if any. SQLCancel may be called from another thread,
+    // so starting, finishing and canceling the operation are serialized by async_mutex.
+    mutable std::mutex async_mutex;
+    SQLUSMALLINT async_function_id = 0;
+    std::future<SQLRETURN> async_result;
+    std::atomic_bool cancel_requested = false;
 };
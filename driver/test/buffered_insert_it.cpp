@@ -0,0 +1,202 @@
+#include "driver/platform/platform.h"
+#include "driver/test/client_utils.h"
+#include "driver/test/client_test_base.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <thread>
+
+// Executions of "INSERT INTO table (columns) VALUES (?, ...)" with BufferedInsertMaxRows set. The rows are counted
+// over a separate connection, so that they are seen only once the batches that buffer them are actually sent.
+class BufferedInsertTest
+    : public ClientTestBase
+{
+public:
+    BufferedInsertTest()
+        : ClientTestBase(/*skip_connect = */true)
+    {
+    }
+
+protected:
+    virtual void SetUp() override {
+        ClientTestBase::SetUp();
+
+        ODBC_CALL_ON_ENV_THROW(henv, SQLAllocHandle(SQL_HANDLE_DBC, henv, &check_hdbc));
+
+        auto cs = fromUTF8<PTChar>("DSN=" + TestEnvironment::getInstance().getDSN());
+        ODBC_CALL_ON_DBC_THROW(check_hdbc, SQLDriverConnect(check_hdbc, NULL, ptcharCast(cs.data()), SQL_NTS, NULL, 0, NULL, SQL_DRIVER_NOPROMPT));
+        ODBC_CALL_ON_DBC_THROW(check_hdbc, SQLAllocHandle(SQL_HANDLE_STMT, check_hdbc, &check_hstmt));
+
+        check("DROP TABLE IF EXISTS buffered_insert_it");
+        createTable();
+    }
+
+    virtual void TearDown() override {
+        // The buffered connection is closed first, so that it doesn't send anything after the table is dropped.
+        if (hstmt) {
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+            hstmt = nullptr;
+        }
+
+        if (hdbc) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+            hdbc = nullptr;
+        }
+
+        if (check_hstmt) {
+            check("DROP TABLE IF EXISTS buffered_insert_it");
+            SQLFreeHandle(SQL_HANDLE_STMT, check_hstmt);
+            check_hstmt = nullptr;
+        }
+
+        if (check_hdbc) {
+            SQLDisconnect(check_hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, check_hdbc);
+            check_hdbc = nullptr;
+        }
+
+        ClientTestBase::TearDown();
+    }
+
+    void createTable() {
+        check("CREATE TABLE buffered_insert_it (id Int32) ENGINE = Memory");
+    }
+
+    // Connect with the buffering options, and prepare the INSERT, with the parameter bound to the id member.
+    void connect(std::uint32_t max_rows, std::uint32_t flush_interval) {
+        ASSERT_EQ(hstmt, nullptr);
+
+        auto cs = fromUTF8<PTChar>(
+            "DSN=" + TestEnvironment::getInstance().getDSN() +
+            ";BufferedInsertMaxRows=" + std::to_string(max_rows) +
+            ";BufferedInsertFlushInterval=" + std::to_string(flush_interval)
+        );
+
+        ODBC_CALL_ON_DBC_THROW(hdbc, SQLDriverConnect(hdbc, NULL, ptcharCast(cs.data()), SQL_NTS, NULL, 0, NULL, SQL_DRIVER_NOPROMPT));
+        ODBC_CALL_ON_DBC_THROW(hdbc, SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt));
+
+        auto query = fromUTF8<PTChar>("INSERT INTO buffered_insert_it (id) VALUES (?)");
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLPrepare(hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &id, sizeof(id), &id_ind));
+    }
+
+    SQLRETURN insert(SQLINTEGER value) {
+        id = value;
+        return SQLExecute(hstmt);
+    }
+
+    void check(const std::string & query_orig) {
+        auto query = fromUTF8<PTChar>(query_orig);
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLExecDirect(check_hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLFreeStmt(check_hstmt, SQL_CLOSE));
+    }
+
+    SQLBIGINT countRows() {
+        auto query = fromUTF8<PTChar>("SELECT count() FROM buffered_insert_it");
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLExecDirect(check_hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLFetch(check_hstmt));
+
+        SQLBIGINT count = -1;
+        SQLLEN count_ind = 0;
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLGetData(check_hstmt, 1, SQL_C_SBIGINT, &count, sizeof(count), &count_ind));
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLFreeStmt(check_hstmt, SQL_CLOSE));
+        return count;
+    }
+
+    // Wait until the expected number of rows is in the table, or the time is out, and return the last count.
+    SQLBIGINT waitForRows(SQLBIGINT expected, std::chrono::milliseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        auto count = countRows();
+
+        while (count != expected && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            count = countRows();
+        }
+
+        return count;
+    }
+
+    // Long enough for none of the batches to be sent by the timer while a test runs.
+    static constexpr std::uint32_t never = 600000;
+
+    SQLHDBC check_hdbc = nullptr;
+    SQLHSTMT check_hstmt = nullptr;
+
+    SQLINTEGER id = 0;
+    SQLLEN id_ind = 0;
+};
+
+TEST_F(BufferedInsertTest, SendsFullBatch) {
+    connect(/*max_rows = */3, never);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(1));
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(2));
+    EXPECT_EQ(countRows(), 0);
+
+    // The execution that fills the batch sends it, and returns once it is inserted.
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(3));
+    EXPECT_EQ(countRows(), 3);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(4));
+    EXPECT_EQ(countRows(), 3);
+}
+
+TEST_F(BufferedInsertTest, SendsBatchByTimer) {
+    connect(/*max_rows = */1000, /*flush_interval = */1000);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(1));
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(2));
+    EXPECT_EQ(countRows(), 0);
+
+    EXPECT_EQ(waitForRows(2, std::chrono::seconds(10)), 2);
+}
+
+TEST_F(BufferedInsertTest, ReportsBackgroundFailureOnNextExecute) {
+    connect(/*max_rows = */1000, /*flush_interval = */500);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(1));
+
+    // The batch is sent by the timer, into a table that doesn't exist anymore.
+    check("DROP TABLE buffered_insert_it");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    createTable();
+
+    ASSERT_EQ(insert(2), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("Failed to insert a batch of 1 buffered rows"));
+
+    // The failure is reported once, and the rows of the failed execution are not buffered.
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(3));
+    ODBC_CALL_ON_DBC_THROW(hdbc, SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT));
+    EXPECT_EQ(countRows(), 1);
+}
+
+TEST_F(BufferedInsertTest, SendsBatchesOnEndTran) {
+    connect(/*max_rows = */1000, never);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(1));
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(2));
+    EXPECT_EQ(countRows(), 0);
+
+    ODBC_CALL_ON_DBC_THROW(hdbc, SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT));
+    EXPECT_EQ(countRows(), 2);
+}
+
+TEST_F(BufferedInsertTest, SendsBatchesOnDisconnect) {
+    connect(/*max_rows = */1000, never);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(1));
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert(2));
+
+    // Closing the statement doesn't send the batch, so that the next executions can add to it.
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+    EXPECT_EQ(countRows(), 0);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeHandle(SQL_HANDLE_STMT, hstmt));
+    hstmt = nullptr;
+
+    ODBC_CALL_ON_DBC_THROW(hdbc, SQLDisconnect(hdbc));
+    EXPECT_EQ(countRows(), 2);
+}
@@ -0,0 +1,167 @@
+#include "driver/platform/platform.h"
+#include "driver/test/client_utils.h"
+#include "driver/test/client_test_base.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cstdio>
+
+// SQLBulkOperations(SQL_ADD) on a result set selected from a single table. The table rejects non-positive ids,
+// so that a rowset can be made to fail on the server, after it has been accepted and sent in the background.
+class BulkOperationsTest
+    : public ClientTestBase
+{
+protected:
+    static constexpr std::size_t row_set_size = 3;
+
+    virtual void SetUp() override {
+        ClientTestBase::SetUp();
+
+        ODBC_CALL_ON_DBC_THROW(hdbc, SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &check_hstmt));
+
+        check("DROP TABLE IF EXISTS bulk_operations_it");
+        check("CREATE TABLE bulk_operations_it (id Int32, name String, CONSTRAINT positive_id CHECK id > 0) ENGINE = Memory");
+    }
+
+    virtual void TearDown() override {
+        if (check_hstmt) {
+            check("DROP TABLE IF EXISTS bulk_operations_it");
+            ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLFreeHandle(SQL_HANDLE_STMT, check_hstmt));
+            check_hstmt = nullptr;
+        }
+
+        ClientTestBase::TearDown();
+    }
+
+    // Select from the query, and bind the id and name columns to the rowset buffers.
+    void selectAndBind(const std::string & query_orig) {
+        auto query = fromUTF8<PTChar>(query_orig);
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)row_set_size, 0));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, row_statuses, 0));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_OPERATION_PTR, row_operations, 0));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 1, SQL_C_SLONG, ids, sizeof(ids[0]), id_inds));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 2, SQL_C_CHAR, names, sizeof(names[0]), name_inds));
+    }
+
+    // Fill the rowset buffers, and add the rows.
+    SQLRETURN add(const std::array<SQLINTEGER, row_set_size> & row_ids, const std::array<SQLUSMALLINT, row_set_size> & operations) {
+        for (std::size_t i = 0; i < row_set_size; ++i) {
+            ids[i] = row_ids[i];
+            id_inds[i] = sizeof(ids[i]);
+            std::snprintf(names[i], sizeof(names[i]), "name %d", static_cast<int>(row_ids[i]));
+            name_inds[i] = SQL_NTS;
+            row_operations[i] = operations[i];
+            row_statuses[i] = unset_status;
+        }
+
+        return SQLBulkOperations(hstmt, SQL_ADD);
+    }
+
+    SQLLEN getRowCount() {
+        SQLLEN row_count = -1;
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLRowCount(hstmt, &row_count));
+        return row_count;
+    }
+
+    void check(const std::string & query_orig) {
+        auto query = fromUTF8<PTChar>(query_orig);
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLExecDirect(check_hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLFreeStmt(check_hstmt, SQL_CLOSE));
+    }
+
+    // The sum of the ids in the table, the ids being distinct powers of two.
+    SQLBIGINT sumIds() {
+        auto query = fromUTF8<PTChar>("SELECT sum(id) FROM bulk_operations_it");
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLExecDirect(check_hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLFetch(check_hstmt));
+
+        SQLBIGINT sum = -1;
+        SQLLEN sum_ind = 0;
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLGetData(check_hstmt, 1, SQL_C_SBIGINT, &sum, sizeof(sum), &sum_ind));
+        ODBC_CALL_ON_STMT_THROW(check_hstmt, SQLFreeStmt(check_hstmt, SQL_CLOSE));
+        return sum;
+    }
+
+    static constexpr SQLUSMALLINT proceed = SQL_ROW_PROCEED;
+    static constexpr SQLUSMALLINT ignore = SQL_ROW_IGNORE;
+    static constexpr SQLUSMALLINT unset_status = 0xBAD;
+
+    SQLHSTMT check_hstmt = nullptr;
+
+    SQLINTEGER ids[row_set_size] = {};
+    SQLLEN id_inds[row_set_size] = {};
+    char names[row_set_size][16] = {};
+    SQLLEN name_inds[row_set_size] = {};
+    SQLUSMALLINT row_operations[row_set_size] = {};
+    SQLUSMALLINT row_statuses[row_set_size] = {};
+};
+
+TEST_F(BulkOperationsTest, AddsRows) {
+    selectAndBind("SELECT id, name FROM bulk_operations_it WHERE id > 0 ORDER BY id");
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, add({1, 2, 4}, {proceed, ignore, proceed}));
+    EXPECT_EQ(getRowCount(), 2);
+
+    // The ignored rows are left alone, the others are serialized, and the first rowset has no predecessor to wait for.
+    EXPECT_EQ(row_statuses[0], SQL_ROW_ADDED);
+    EXPECT_EQ(row_statuses[1], unset_status);
+    EXPECT_EQ(row_statuses[2], SQL_ROW_ADDED);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, add({8, 16, 32}, {proceed, proceed, proceed}));
+    EXPECT_EQ(getRowCount(), 3);
+
+    // The last rowset is known to be inserted once the cursor is closed.
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLCloseCursor(hstmt));
+    EXPECT_EQ(sumIds(), 1 + 4 + 8 + 16 + 32);
+}
+
+TEST_F(BulkOperationsTest, ReportsFailureOnNextCall) {
+    selectAndBind("SELECT id, name FROM bulk_operations_it");
+
+    // The rowset is accepted, and rejected by the server in the background.
+    ODBC_CALL_ON_STMT_THROW(hstmt, add({1, -2, 4}, {proceed, proceed, proceed}));
+
+    ASSERT_EQ(add({8, 16, 32}, {proceed, proceed, proceed}), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("positive_id"));
+
+    // Neither rowset is inserted, the second one is not sent after the failure of the first one.
+    for (std::size_t i = 0; i < row_set_size; ++i) {
+        EXPECT_NE(row_statuses[i], SQL_ROW_ADDED) << "row " << i;
+    }
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLCloseCursor(hstmt));
+    EXPECT_EQ(sumIds(), 0);
+}
+
+TEST_F(BulkOperationsTest, ReportsFailureOnClose) {
+    selectAndBind("SELECT id, name FROM bulk_operations_it");
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, add({1, 2, 4}, {proceed, proceed, proceed}));
+    ODBC_CALL_ON_STMT_THROW(hstmt, add({8, -16, 32}, {proceed, proceed, proceed}));
+
+    ASSERT_EQ(SQLCloseCursor(hstmt), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("positive_id"));
+
+    EXPECT_EQ(sumIds(), 1 + 2 + 4);
+}
+
+TEST_F(BulkOperationsTest, RejectsAmbiguousTarget) {
+    // Rows can't be added to a table function, or to a join.
+    for (const auto * query : {
+        "SELECT number AS id, toString(number) AS name FROM numbers(3)",
+        "SELECT t.id, t.name FROM bulk_operations_it AS t JOIN bulk_operations_it AS u ON t.id = u.id"
+    }) {
+        selectAndBind(query);
+
+        ASSERT_EQ(add({1, 2, 4}, {proceed, proceed, proceed}), SQL_ERROR) << query;
+        EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HYC00]")) << query;
+
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLCloseCursor(hstmt));
+    }
+
+    EXPECT_EQ(sumIds(), 0);
+}
@@ -0,0 +1,481 @@
+// Self-contained throughput benchmark of the value conversion layer (utils/type_info.h).
+//
+// Drives writeDataFrom() (via Field::extract(), the way result sets do) for every source type that
+// a result set can hold, and readReadyDataTo() (the way parameters are serialized) for every C type,
+// over randomly generated but realistic value distributions.
+//
+// Prints one JSON object per line per (source type, C type) combination, e.g.:
+//   {"benchmark":"write","source":"Int32","c_type":"SQL_C_CHAR","supported":true,"values":100000,"failed_values":0,"ns_per_value":9.876,"allocs_per_value":0.000}
+//
+// Usage: conversion-benchmark [--values=N] [--repeat=N] [--filter=SUBSTRING]
+// "failed_values" counts generated values that the conversion rejects (e.g., out of range for the C type), those are excluded from timing.
+
+#include "driver/platform/platform.h"
+#include "driver/utils/type_info.h"
+#include "driver/result_set.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> allocation_count{0};
+
+} // namespace
+
+void * operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void * ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void * ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+struct Options {
+    std::size_t values = 100'000;
+    std::size_t repeat = 5;
+    std::string filter;
+};
+
+struct CTypeInfo {
+    SQLSMALLINT c_type;
+    const char * name;
+};
+
+const CTypeInfo c_types[] = {
+    { SQL_C_CHAR,           "SQL_C_CHAR"           },
+    { SQL_C_WCHAR,          "SQL_C_WCHAR"          },
+    { SQL_C_BINARY,         "SQL_C_BINARY"         },
+    { SQL_C_BIT,            "SQL_C_BIT"            },
+    { SQL_C_STINYINT,       "SQL_C_STINYINT"       },
+    { SQL_C_UTINYINT,       "SQL_C_UTINYINT"       },
+    { SQL_C_SSHORT,         "SQL_C_SSHORT"         },
+    { SQL_C_USHORT,         "SQL_C_USHORT"         },
+    { SQL_C_SLONG,          "SQL_C_SLONG"          },
+    { SQL_C_ULONG,          "SQL_C_ULONG"          },
+    { SQL_C_SBIGINT,        "SQL_C_SBIGINT"        },
+    { SQL_C_UBIGINT,        "SQL_C_UBIGINT"        },
+    { SQL_C_FLOAT,          "SQL_C_FLOAT"          },
+    { SQL_C_DOUBLE,         "SQL_C_DOUBLE"         },
+    { SQL_C_GUID,           "SQL_C_GUID"           },
+    { SQL_C_NUMERIC,        "SQL_C_NUMERIC"        },
+    { SQL_C_TYPE_DATE,      "SQL_C_TYPE_DATE"      },
+    { SQL_C_TYPE_TIME,      "SQL_C_TYPE_TIME"      },
+    { SQL_C_TYPE_TIMESTAMP, "SQL_C_TYPE_TIMESTAMP" }
+};
+
+// Big enough for any fixed-size C type and for the longest generated string in any encoding.
+constexpr std::size_t buffer_size = 512;
+
+// Number of leading values that all have to be rejected for a combination to be reported as unsupported.
+constexpr std::size_t unsupported_probe_size = 64;
+
+// Timezone storage referenced by Wire*AsInt values, must outlive them.
+const std::string wire_timezone;
+
+class ValueGenerator {
+public:
+    explicit ValueGenerator(std::uint64_t seed) : rng(seed) {}
+
+    // Integers of all magnitudes, not just the ones close to the type limits.
+    template <typename T>
+    T integer() {
+        constexpr auto bits = sizeof(T) * 8;
+        const auto shift = uniform(0, bits - 1);
+        const auto value = static_cast<T>(rng() >> (64 - bits + shift));
+        return (std::is_signed_v<T> && (rng() & 1) ? static_cast<T>(-value) : value);
+    }
+
+    template <typename T>
+    T floating() {
+        const auto exponent = static_cast<int>(uniform(0, 12)) - 4;
+        return static_cast<T>(std::normal_distribution<double>{0.0, 1.0}(rng) * std::pow(10.0, exponent));
+    }
+
+    DataSourceType<DataSourceTypeId::Decimal> decimal(std::int16_t precision, std::int16_t scale) {
+        DataSourceType<DataSourceTypeId::Decimal> result;
+        result.precision = precision;
+        result.scale = scale;
+        result.sign = (rng() & 1); // 0 means negative.
+
+        // Four 32-bit draws fill the widest mantissa, the upper ones are shifted out of a narrower one.
+        DecimalMantissaType mantissa = 0;
+        for (int i = 0; i < 4; ++i) {
+            mantissa = (mantissa << 32) | DecimalMantissaType{rng() & 0xFFFFFFFFu};
+        }
+
+        const auto digits = std::min<std::size_t>(uniform(1, precision), value_manip::decimal::max_pow10);
+        const auto limit = value_manip::decimal::pow10_table[digits];
+        result.value = mantissa % limit;
+
+        return result;
+    }
+
+    std::string string(std::size_t min_size, std::size_t max_size) {
+        static constexpr char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 _-.,";
+        static constexpr const char * non_ascii[] = { "\xC3\xA9", "\xD0\x96", "\xE4\xB8\x96" }; // é, Ж, 世
+
+        std::string result;
+        const auto size = uniform(min_size, max_size);
+        while (result.size() < size) {
+            if (uniform(0, 15) == 0)
+                result += non_ascii[uniform(0, lengthof(non_ascii) - 1)];
+            else
+                result += alphabet[uniform(0, lengthof(alphabet) - 2)];
+        }
+
+        return result;
+    }
+
+    SQL_TIMESTAMP_STRUCT timestamp(bool with_fraction) {
+        SQL_TIMESTAMP_STRUCT result = {};
+        value_manip::datetime::civilFromDays(uniform(0, 49709), result);
+        result.hour = uniform(0, 23);
+        result.minute = uniform(0, 59);
+        result.second = uniform(0, 59);
+        result.fraction = (with_fraction ? uniform(0, 999) * 1'000'000 : 0);
+        return result;
+    }
+
+    SQLGUID guid() {
+        SQLGUID result;
+        const std::uint64_t halves[] = { rng(), rng() };
+        std::memcpy(&result, halves, sizeof(result));
+        return result;
+    }
+
+    std::size_t uniform(std::size_t from, std::size_t to) {
+        return std::uniform_int_distribution<std::size_t>{from, to}(rng);
+    }
+
+private:
+    std::mt19937_64 rng;
+};
+
+struct SourceInfo {
+    const char * name;
+    std::function<Field::DataType (ValueGenerator &)> generate;
+};
+
+template <DataSourceTypeId Id, typename Fn>
+SourceInfo makeSource(const char * name, Fn && fn) {
+    return { name, [fn] (ValueGenerator & gen) -> Field::DataType {
+        DataSourceType<Id> value;
+        value.value = fn(gen);
+        return value;
+    } };
+}
+
+template <DataSourceTypeId Id>
+SourceInfo makeDecimalSource(const char * name, std::int16_t precision, std::int16_t scale) {
+    return { name, [precision, scale] (ValueGenerator & gen) -> Field::DataType {
+        DataSourceType<Id> value;
+        static_cast<DataSourceType<DataSourceTypeId::Decimal> &>(value) = gen.decimal(precision, scale);
+        return value;
+    } };
+}
+
+std::vector<SourceInfo> makeSources() {
+    return {
+        makeSource<DataSourceTypeId::Int8>       ("Int8",        [] (auto & gen) { return gen.template integer<std::int8_t>();   }),
+        makeSource<DataSourceTypeId::UInt8>      ("UInt8",       [] (auto & gen) { return gen.template integer<std::uint8_t>();  }),
+        makeSource<DataSourceTypeId::Int16>      ("Int16",       [] (auto & gen) { return gen.template integer<std::int16_t>();  }),
+        makeSource<DataSourceTypeId::UInt16>     ("UInt16",      [] (auto & gen) { return gen.template integer<std::uint16_t>(); }),
+        makeSource<DataSourceTypeId::Int32>      ("Int32",       [] (auto & gen) { return gen.template integer<std::int32_t>();  }),
+        makeSource<DataSourceTypeId::UInt32>     ("UInt32",      [] (auto & gen) { return gen.template integer<std::uint32_t>(); }),
+        makeSource<DataSourceTypeId::Int64>      ("Int64",       [] (auto & gen) { return gen.template integer<std::int64_t>();  }),
+        makeSource<DataSourceTypeId::UInt64>     ("UInt64",      [] (auto & gen) { return gen.template integer<std::uint64_t>(); }),
+        makeSource<DataSourceTypeId::Float32>    ("Float32",     [] (auto & gen) { return gen.template floating<float>();        }),
+        makeSource<DataSourceTypeId::Float64>    ("Float64",     [] (auto & gen) { return gen.template floating<double>();       }),
+        makeDecimalSource<DataSourceTypeId::Decimal>    ("Decimal",    18,  4),
+        makeDecimalSource<DataSourceTypeId::Decimal32>  ("Decimal32",   9,  2),
+        makeDecimalSource<DataSourceTypeId::Decimal64>  ("Decimal64",  18,  4),
+        makeDecimalSource<DataSourceTypeId::Decimal128> ("Decimal128", 38, 10),
+        makeSource<DataSourceTypeId::String>     ("String",      [] (auto & gen) { return gen.string(0, 64);                     }),
+        makeSource<DataSourceTypeId::FixedString>("FixedString", [] (auto & gen) { return gen.string(16, 16);                    }),
+        makeSource<DataSourceTypeId::Date>       ("Date",        [] (auto & gen) {
+            const auto timestamp = gen.timestamp(false);
+            return SQL_DATE_STRUCT{ timestamp.year, timestamp.month, timestamp.day };
+        }),
+        makeSource<DataSourceTypeId::DateTime>   ("DateTime",    [] (auto & gen) { return gen.timestamp(false);                  }),
+        makeSource<DataSourceTypeId::DateTime64> ("DateTime64",  [] (auto & gen) { return gen.timestamp(true);                   }),
+        makeSource<DataSourceTypeId::UUID>       ("UUID",        [] (auto & gen) { return gen.guid();                            }),
+        { "WireTypeAnyAsString(Int64)", [] (ValueGenerator & gen) -> Field::DataType {
+            return WireTypeAnyAsString{std::to_string(gen.integer<std::int64_t>())};
+        } },
+        { "WireTypeAnyAsString(Float64)", [] (ValueGenerator & gen) -> Field::DataType {
+            std::string value;
+            value_manip::from_value<double>::template to_value<std::string>::convert(gen.floating<double>(), value);
+            return WireTypeAnyAsString{value};
+        } },
+        { "WireTypeAnyAsString(DateTime)", [] (ValueGenerator & gen) -> Field::DataType {
+            std::string value;
+            value_manip::from_value<SQL_TIMESTAMP_STRUCT>::template to_value<std::string>::convert(gen.timestamp(false), value);
+            return WireTypeAnyAsString{value};
+        } },
+        { "WireTypeDateAsInt", [] (ValueGenerator & gen) -> Field::DataType {
+            WireTypeDateAsInt value(wire_timezone);
+            value.value = gen.uniform(0, 49709);
+            return value;
+        } },
+        { "WireTypeDateTimeAsInt", [] (ValueGenerator & gen) -> Field::DataType {
+            WireTypeDateTimeAsInt value(wire_timezone);
+            value.value = gen.integer<std::uint32_t>();
+            return value;
+        } },
+        { "WireTypeDateTime64AsInt", [] (ValueGenerator & gen) -> Field::DataType {
+            WireTypeDateTime64AsInt value(3, wire_timezone);
+            value.value = static_cast<std::int64_t>(gen.integer<std::uint32_t>()) * 1000 + gen.uniform(0, 999);
+            return value;
+        } }
+    };
+}
+
+// The source type that naturally fills a bound parameter buffer of the given C type.
+const char * naturalSourceFor(SQLSMALLINT c_type) {
+    switch (c_type) {
+        case SQL_C_CHAR:
+        case SQL_C_WCHAR:
+        case SQL_C_BINARY:         return "String";
+        case SQL_C_BIT:            return "UInt8";
+        case SQL_C_STINYINT:       return "Int8";
+        case SQL_C_UTINYINT:       return "UInt8";
+        case SQL_C_SSHORT:         return "Int16";
+        case SQL_C_USHORT:         return "UInt16";
+        case SQL_C_SLONG:          return "Int32";
+        case SQL_C_ULONG:          return "UInt32";
+        case SQL_C_SBIGINT:        return "Int64";
+        case SQL_C_UBIGINT:        return "UInt64";
+        case SQL_C_FLOAT:          return "Float32";
+        case SQL_C_DOUBLE:         return "Float64";
+        case SQL_C_GUID:           return "UUID";
+        case SQL_C_NUMERIC:        return "Decimal64";
+        case SQL_C_TYPE_DATE:      return "Date";
+        case SQL_C_TYPE_TIME:      return "WireTypeAnyAsString(DateTime)";
+        case SQL_C_TYPE_TIMESTAMP: return "DateTime64";
+        default:                   return "";
+    }
+}
+
+struct Measurement {
+    bool supported = false;
+    std::size_t values = 0;
+    std::size_t failed_values = 0;
+    double ns_per_value = 0;
+    double allocs_per_value = 0;
+};
+
+void report(const char * benchmark, const char * source, const char * c_type, const Measurement & m) {
+    char buf[512];
+    std::snprintf(buf, lengthof(buf),
+        "{\"benchmark\":\"%s\",\"source\":\"%s\",\"c_type\":\"%s\",\"supported\":%s,\"values\":%zu,\"failed_values\":%zu,\"ns_per_value\":%.3f,\"allocs_per_value\":%.3f}",
+        benchmark, source, c_type, (m.supported ? "true" : "false"), m.values, m.failed_values, m.ns_per_value, m.allocs_per_value
+    );
+    std::cout << buf << std::endl;
+}
+
+// Runs 'fn(i)' for every i in 'count', 'repeat' times, and returns the best per-value time and the allocation rate.
+template <typename F>
+void measure(std::size_t count, std::size_t repeat, Measurement & m, F && fn) {
+    double best_ns = -1;
+    std::uint64_t allocations = 0;
+
+    for (std::size_t r = 0; r < repeat; ++r) {
+        const auto allocations_before = allocation_count.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        allocations = allocation_count.load(std::memory_order_relaxed) - allocations_before;
+
+        const auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        if (best_ns < 0 || ns < best_ns)
+            best_ns = ns;
+    }
+
+    m.values = count;
+    m.ns_per_value = (count ? best_ns / count : 0);
+    m.allocs_per_value = (count ? static_cast<double>(allocations) / count : 0);
+}
+
+BindingInfo makeBinding(SQLSMALLINT c_type, void * buffer, SQLLEN * value_size, SQLLEN * indicator) {
+    BindingInfo binding;
+    binding.c_type = c_type;
+    binding.value = buffer;
+    binding.value_max_size = buffer_size;
+    binding.value_size = value_size;
+    binding.indicator = indicator;
+    binding.precision = 38;
+    binding.scale = 4;
+    return binding;
+}
+
+void benchmarkWrite(const Options & options, const std::vector<SourceInfo> & sources) {
+    DefaultConversionContext context;
+
+    alignas(16) char buffer[buffer_size];
+    SQLLEN value_size = 0;
+    SQLLEN indicator = 0;
+
+    for (const auto & source : sources) {
+        ValueGenerator gen(1);
+        std::vector<Field> fields(options.values);
+        for (auto & field : fields) {
+            field.data = source.generate(gen);
+        }
+
+        for (const auto & c_type : c_types) {
+            if (!options.filter.empty() && (std::string{source.name} + " " + c_type.name).find(options.filter) == std::string::npos)
+                continue;
+
+            auto binding = makeBinding(c_type.c_type, buffer, &value_size, &indicator);
+
+            // Keep only the values the conversion accepts, so that exception handling doesn't dominate the timing.
+            // If none of the first values is accepted, the combination is considered unsupported altogether.
+            std::vector<Field> accepted;
+            accepted.reserve(fields.size());
+            std::size_t tried = 0;
+            for (; tried < fields.size(); ++tried) {
+                if (tried == unsupported_probe_size && accepted.empty())
+                    break;
+
+                try {
+                    fields[tried].extract(binding, context);
+                    accepted.push_back(fields[tried]);
+                }
+                catch (...) {
+                }
+            }
+
+            Measurement m;
+            m.supported = !accepted.empty();
+            m.failed_values = tried - accepted.size();
+
+            if (m.supported) {
+                measure(accepted.size(), options.repeat, m, [&] (std::size_t i) {
+                    accepted[i].extract(binding, context);
+                });
+            }
+
+            report("write", source.name, c_type.name, m);
+        }
+    }
+}
+
+void benchmarkRead(const Options & options, const std::vector<SourceInfo> & sources) {
+    DefaultConversionContext context;
+
+    for (const auto & c_type : c_types) {
+        const std::string source_name = naturalSourceFor(c_type.c_type);
+        if (!options.filter.empty() && (source_name + " " + c_type.name).find(options.filter) == std::string::npos)
+            continue;
+
+        const auto source = std::find_if(sources.begin(), sources.end(), [&] (auto & s) { return source_name == s.name; });
+        if (source == sources.end())
+            continue;
+
+        // Prepare an array of bound parameter buffers, filled the same way an application would.
+        std::vector<char> buffers(options.values * buffer_size);
+        std::vector<SQLLEN> value_sizes(options.values);
+        std::vector<SQLLEN> indicators(options.values);
+        std::vector<BindingInfo> bindings;
+        bindings.reserve(options.values);
+
+        ValueGenerator gen(2);
+        std::size_t failed_values = 0;
+        for (std::size_t i = 0; i < options.values; ++i) {
+            if (i == unsupported_probe_size && bindings.empty())
+                break;
+
+            auto binding = makeBinding(c_type.c_type, &buffers[i * buffer_size], &value_sizes[i], &indicators[i]);
+            Field field;
+            field.data = source->generate(gen);
+
+            try {
+                field.extract(binding, context);
+                std::string probe;
+                readReadyDataTo(binding, probe);
+                bindings.push_back(binding);
+            }
+            catch (...) {
+                ++failed_values;
+            }
+        }
+
+        Measurement m;
+        m.supported = !bindings.empty();
+        m.failed_values = failed_values;
+
+        if (m.supported) {
+            measure(bindings.size(), options.repeat, m, [&] (std::size_t i) {
+                std::string value; // A fresh string per value, like Statement::prepareHttpRequest() does.
+                readReadyDataTo(bindings[i], value);
+            });
+        }
+
+        report("read", source_name.c_str(), c_type.name, m);
+    }
+}
+
+Options parseOptions(int argc, char * argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value_of = [&] (const std::string & prefix) {
+            return (arg.compare(0, prefix.size(), prefix) == 0 ? arg.substr(prefix.size()) : std::string{});
+        };
+
+        if (const auto value = value_of("--values="); !value.empty())
+            options.values = std::stoull(value);
+        else if (const auto value = value_of("--repeat="); !value.empty())
+            options.repeat = std::max<std::size_t>(1, std::stoull(value));
+        else if (const auto value = value_of("--filter="); !value.empty())
+            options.filter = value;
+        else
+            throw std::runtime_error("Unknown argument: " + arg);
+    }
+
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    try {
+        const auto options = parseOptions(argc, argv);
+        const auto sources = makeSources();
+
+        benchmarkWrite(options, sources);
+        benchmarkRead(options, sources);
+    }
+    catch (const std::exception & ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
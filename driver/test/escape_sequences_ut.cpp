@@ -323,3 +323,39 @@ TEST(EscapeSequencesCase, LTRIM) {
     ASSERT_EQ(replaceEscapeSequences("{fn LTRIM(`dm_ExperimentsData`.`Campaign`)}"),
         "replaceRegexpOne(`dm_ExperimentsData`.`Campaign`, '^\\\\s+', '')");
 }
+
+TEST(EscapeSequencesCase, QuotedTextAndComments) {
+    ASSERT_EQ(replaceEscapeSequences("SELECT '{fn ABS(1)}', {fn ABS(1)}"), "SELECT '{fn ABS(1)}', abs(1)");
+    ASSERT_EQ(replaceEscapeSequences("SELECT {fn ABS(1)} -- {fn ABS(2)}"), "SELECT abs(1) -- {fn ABS(2)}");
+    ASSERT_EQ(replaceEscapeSequences("SELECT {'a': 1}"), "SELECT {'a': 1}");
+}
+
+TEST(PrepareQueryTemplate, ParameterMarkers) {
+    const auto prepared = prepareQueryTemplate(
+        "SELECT ?, '?', `a?`, @name /* ? */, {fn CONCAT(?, 'x')}, @x -- ?\n"
+        "WHERE x = ?", true);
+
+    ASSERT_EQ(prepared.query,
+        "SELECT ?, '?', `a?`, @name /* ? */, concat(?, 'x'), @x -- ?\n"
+        "WHERE x = ?");
+
+    ASSERT_EQ(prepared.parameters.size(), 5);
+
+    std::vector<std::string> markers;
+    for (const auto & param : prepared.parameters) {
+        markers.push_back(prepared.query.substr(param.marker_pos, param.marker_size));
+    }
+    ASSERT_EQ(markers, (std::vector<std::string>{"?", "@name", "?", "@x", "?"}));
+    ASSERT_EQ(prepared.parameters[1].name, "@name");
+    ASSERT_TRUE(prepared.parameters[0].name.empty());
+}
+
+TEST(PrepareQueryTemplate, NoScan) {
+    const auto prepared = prepareQueryTemplate("SELECT {fn ABS(?)}", false);
+    ASSERT_EQ(prepared.query, "SELECT {fn ABS(?)}");
+    ASSERT_EQ(prepared.parameters.size(), 1);
+    ASSERT_EQ(prepared.parameters[0].marker_pos, 15);
+
+    ASSERT_TRUE(prepareQueryTemplate("SELECT 1", true).parameters.empty());
+    ASSERT_THROW(prepareQueryTemplate("SELECT @", true), SqlException);
+}
@@ -5,6 +5,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <chrono>
+#include <thread>
+
 class MiscellaneousTest
     : public ClientTestBase
 {
@@ -149,6 +152,93 @@ TEST_F(MiscellaneousTest, NullableNothing) {
     EXPECT_EQ(nullable, SQL_NULLABLE);
 }
 
+TEST_F(MiscellaneousTest, AsyncExecutionPollAndCancel) {
+    const auto poll = [&] (const auto & call) {
+        SQLRETURN rc = SQL_STILL_EXECUTING;
+        while ((rc = call()) == SQL_STILL_EXECUTING)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return rc;
+    };
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0));
+
+    {
+        auto query = fromUTF8<PTChar>("SELECT 42 AS col, sleep(1)");
+        const auto execute = [&] () { return SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS); };
+
+        ASSERT_EQ(execute(), SQL_STILL_EXECUTING);
+
+        // Only the polls of the operation, SQLCancel and SQLGetDiag* may be called on the statement until it completes.
+        SQLSMALLINT column_count = 0;
+        ASSERT_EQ(SQLNumResultCols(hstmt, &column_count), SQL_ERROR);
+        EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY010]"));
+
+        ASSERT_EQ(SQLFetch(hstmt), SQL_ERROR);
+        EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY010]"));
+
+        ODBC_CALL_ON_STMT_THROW(hstmt, poll(execute));
+        ODBC_CALL_ON_STMT_THROW(hstmt, poll([&] () { return SQLFetch(hstmt); }));
+
+        SQLINTEGER col = 0;
+        SQLLEN col_ind = 0;
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 1, SQL_C_SLONG, &col, sizeof(col), &col_ind));
+        EXPECT_EQ(col, 42);
+
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+    }
+
+    {
+        // Each block sleeps for 3 seconds, so the first one isn't sent before the query is canceled.
+        auto query = fromUTF8<PTChar>("SELECT sleep(3) FROM numbers(10) SETTINGS max_block_size = 1");
+        const auto execute = [&] () { return SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS); };
+
+        ASSERT_EQ(execute(), SQL_STILL_EXECUTING);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        // The request is aborted, instead of waiting for the server to respond.
+        const auto canceled_at = std::chrono::steady_clock::now();
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLCancel(hstmt));
+        ASSERT_EQ(poll(execute), SQL_ERROR);
+        EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY008]"));
+        EXPECT_LT(std::chrono::steady_clock::now() - canceled_at, std::chrono::seconds(2));
+    }
+
+    // The statement is usable again.
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, 0));
+
+    auto query = fromUTF8<PTChar>("SELECT 1");
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+}
+
+TEST_F(MiscellaneousTest, MaxRowsAttribute) {
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)3, 0));
+
+    auto query = fromUTF8<PTChar>("SELECT number FROM numbers(100)");
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+
+    SQLRETURN rc = SQL_SUCCESS;
+    std::size_t row_count = 0;
+    while ((rc = SQLFetch(hstmt)) != SQL_NO_DATA) {
+        ODBC_CALL_ON_STMT_THROW(hstmt, rc);
+        ++row_count;
+    }
+
+    EXPECT_EQ(row_count, 3);
+}
+
+TEST_F(MiscellaneousTest, QueryTimeoutAttribute) {
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)1, 0));
+
+    auto query = fromUTF8<PTChar>("SELECT sleep(3)");
+
+    // The query is stopped by the server, or the response is given up on a second later, either way long before it completes.
+    const auto started_at = std::chrono::steady_clock::now();
+    ASSERT_EQ(SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HYT00]"));
+    EXPECT_LT(std::chrono::steady_clock::now() - started_at, std::chrono::milliseconds(2500));
+}
+
 enum class FailOn {
     Connect,
     Execute,
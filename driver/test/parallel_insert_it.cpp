@@ -0,0 +1,148 @@
+#include "driver/platform/platform.h"
+#include "driver/test/client_utils.h"
+#include "driver/test/client_test_base.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cstring>
+
+// Executions of "INSERT INTO table (columns) VALUES (?, ...)" with an array of parameter sets that is large enough
+// for ParallelInsertThreshold, so that it is split into RowBinary chunks, one per stream here.
+class ParallelInsertTest
+    : public ClientTestBase
+{
+public:
+    ParallelInsertTest()
+        : ClientTestBase(/*skip_connect = */true)
+    {
+    }
+
+protected:
+    virtual void SetUp() override {
+        ClientTestBase::SetUp();
+
+        // 10 parameter sets over 2 streams are sent in 2 chunks of 5.
+        auto cs = fromUTF8<PTChar>("DSN=" + TestEnvironment::getInstance().getDSN() + ";ParallelInsertThreshold=4;ParallelInsertStreams=2");
+        ODBC_CALL_ON_DBC_THROW(hdbc, SQLDriverConnect(hdbc, NULL, ptcharCast(cs.data()), SQL_NTS, NULL, 0, NULL, SQL_DRIVER_NOPROMPT));
+        ODBC_CALL_ON_DBC_THROW(hdbc, SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt));
+
+        execute("DROP TABLE IF EXISTS parallel_insert_it");
+        execute("CREATE TABLE parallel_insert_it (id Int32) ENGINE = Memory");
+    }
+
+    virtual void TearDown() override {
+        if (hstmt) {
+            SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+            SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+            SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, NULL, 0);
+            SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, NULL, 0);
+            SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_OPERATION_PTR, NULL, 0);
+            execute("DROP TABLE IF EXISTS parallel_insert_it");
+        }
+
+        ClientTestBase::TearDown();
+    }
+
+    void execute(const std::string & query_orig) {
+        auto query = fromUTF8<PTChar>(query_orig);
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+    }
+
+    // Insert the values, as text, with the given operation for each parameter set, and return the result of SQLExecute.
+    template <std::size_t N>
+    SQLRETURN insert(const std::array<const char *, N> & values, const std::array<SQLUSMALLINT, N> & operations) {
+        for (std::size_t i = 0; i < N; ++i) {
+            std::strncpy(value_buffers[i], values[i], sizeof(value_buffers[i]) - 1);
+            value_inds[i] = SQL_NTS;
+            param_operations[i] = operations[i];
+            param_statuses[i] = 0xBAD;
+        }
+
+        params_processed = 0;
+
+        auto query = fromUTF8<PTChar>("INSERT INTO parallel_insert_it (id) VALUES (?)");
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLPrepare(hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)N, 0));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, param_statuses, 0));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &params_processed, 0));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_OPERATION_PTR, param_operations, 0));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 16, 0, value_buffers, sizeof(value_buffers[0]), value_inds));
+
+        return SQLExecute(hstmt);
+    }
+
+    SQLLEN getRowCount() {
+        SQLLEN row_count = -1;
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLRowCount(hstmt, &row_count));
+        return row_count;
+    }
+
+    SQLBIGINT countRows() {
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_RESET_PARAMS));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0));
+
+        auto query = fromUTF8<PTChar>("SELECT count() FROM parallel_insert_it");
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+
+        SQLBIGINT count = -1;
+        SQLLEN count_ind = 0;
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 1, SQL_C_SBIGINT, &count, sizeof(count), &count_ind));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+        return count;
+    }
+
+    static constexpr std::size_t max_param_set_count = 10;
+
+    char value_buffers[max_param_set_count][16] = {};
+    SQLLEN value_inds[max_param_set_count] = {};
+    SQLUSMALLINT param_operations[max_param_set_count] = {};
+    SQLUSMALLINT param_statuses[max_param_set_count] = {};
+    SQLULEN params_processed = 0;
+};
+
+TEST_F(ParallelInsertTest, InsertsAllChunks) {
+    constexpr auto proceed = SQLUSMALLINT{SQL_PARAM_PROCEED};
+    constexpr auto ignore = SQLUSMALLINT{SQL_PARAM_IGNORE};
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, insert<10>(
+        {"1", "2", "3", "4", "5", "6", "7", "8", "9", "10"},
+        {proceed, ignore, proceed, proceed, proceed, proceed, proceed, proceed, proceed, proceed}
+    ));
+
+    EXPECT_EQ(params_processed, 10u);
+    EXPECT_EQ(getRowCount(), 9);
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(param_statuses[i], (i == 1 ? SQL_PARAM_UNUSED : SQL_PARAM_SUCCESS)) << "parameter set " << i;
+    }
+
+    EXPECT_EQ(countRows(), 9);
+}
+
+TEST_F(ParallelInsertTest, ReportsFailedChunk) {
+    constexpr auto proceed = SQLUSMALLINT{SQL_PARAM_PROCEED};
+    constexpr auto ignore = SQLUSMALLINT{SQL_PARAM_IGNORE};
+
+    // The second chunk has a value that can't be converted to the column type, so none of its rows are inserted.
+    ASSERT_EQ(insert<10>(
+        {"1", "2", "3", "4", "5", "6", "7", "not a number", "9", "10"},
+        {proceed, proceed, proceed, proceed, proceed, proceed, ignore, proceed, proceed, proceed}
+    ), SQL_ERROR);
+
+    EXPECT_EQ(params_processed, 10u);
+    EXPECT_EQ(getRowCount(), 5);
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(param_statuses[i], SQL_PARAM_SUCCESS) << "parameter set " << i;
+    }
+
+    for (std::size_t i = 5; i < 10; ++i) {
+        EXPECT_EQ(param_statuses[i], (i == 6 ? SQL_PARAM_UNUSED : SQL_PARAM_ERROR)) << "parameter set " << i;
+    }
+
+    EXPECT_EQ(countRows(), 5);
+}
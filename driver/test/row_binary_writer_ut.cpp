@@ -0,0 +1,158 @@
+#include "driver/format/RowBinaryWriter.h"
+#include "driver/exception.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+namespace {
+
+template <typename T>
+BindingInfo makeBinding(SQLSMALLINT c_type, T & value, SQLLEN * indicator = nullptr) {
+    BindingInfo binding;
+    binding.c_type = c_type;
+    binding.value = &value;
+    binding.value_max_size = sizeof(T);
+    binding.value_size = indicator;
+    binding.indicator = indicator;
+    return binding;
+}
+
+} // namespace
+
+TEST(RowBinaryWriter, NativeColumnsAreInsertedDirectly) {
+    RowBinaryWriter writer({
+        {"id", "UInt64", SQL_C_SLONG},
+        {"name", "LowCardinality(Nullable(String))", SQL_C_CHAR},
+        {"day", "Date", SQL_C_TYPE_DATE},
+        {"code", "FixedString(4)", SQL_C_CHAR}
+    });
+
+    EXPECT_EQ(writer.buildInsertQuery("db.t"), "INSERT INTO db.t (`id`, `name`, `day`, `code`) FORMAT RowBinary");
+
+    SQLINTEGER id = 300;
+    char name[] = "abc";
+    SQLLEN name_ind = SQL_NTS;
+    SQL_DATE_STRUCT day{1970, 1, 3};
+    char code[] = "xy";
+    SQLLEN code_ind = SQL_NTS;
+    SQLLEN null_ind = SQL_NULL_DATA;
+
+    std::string body;
+    writer.writeValue(0, makeBinding(SQL_C_SLONG, id), body);
+    writer.writeValue(1, makeBinding(SQL_C_CHAR, name, &name_ind), body);
+    writer.writeValue(2, makeBinding(SQL_C_TYPE_DATE, day), body);
+    writer.writeValue(3, makeBinding(SQL_C_CHAR, code, &code_ind), body);
+
+    writer.writeValue(0, makeBinding(SQL_C_SLONG, id), body);
+    writer.writeValue(1, makeBinding(SQL_C_CHAR, name, &null_ind), body);
+    writer.writeValue(2, makeBinding(SQL_C_TYPE_DATE, day), body);
+    writer.writeValue(3, makeBinding(SQL_C_CHAR, code, &code_ind), body);
+
+    const std::string row1(
+        "\x2C\x01\x00\x00\x00\x00\x00\x00" // UInt64 300
+        "\x00\x03" "abc"                    // not NULL, length 3
+        "\x02\x00"                          // Date 1970-01-03
+        "xy\x00\x00",                       // FixedString(4)
+        8 + 5 + 2 + 4
+    );
+    const std::string row2(
+        "\x2C\x01\x00\x00\x00\x00\x00\x00"
+        "\x01"                              // NULL
+        "\x02\x00"
+        "xy\x00\x00",
+        8 + 1 + 2 + 4
+    );
+
+    EXPECT_EQ(body, row1 + row2);
+}
+
+TEST(RowBinaryWriter, OtherValuesAreConvertedByServer) {
+    RowBinaryWriter writer({
+        {"n", "Int32", SQL_C_CHAR},
+        {"ts", "Nullable(DateTime)", SQL_C_CHAR}
+    });
+
+    EXPECT_EQ(
+        writer.buildInsertQuery("t"),
+        "INSERT INTO t (`n`, `ts`) SELECT * FROM input('`n` String, `ts` Nullable(String)') FORMAT RowBinary"
+    );
+
+    char n[] = "42";
+    SQLLEN n_ind = SQL_NTS;
+
+    std::string body;
+    writer.writeValue(0, makeBinding(SQL_C_CHAR, n, &n_ind), body);
+    EXPECT_EQ(body, std::string("\x02" "42"));
+}
+
+TEST(RowBinaryWriter, RejectsInvalidValues) {
+    RowBinaryWriter writer({
+        {"small", "UInt8", SQL_C_SLONG},
+        {"whole", "Int16", SQL_C_DOUBLE},
+        {"code", "FixedString(2)", SQL_C_CHAR}
+    });
+
+    std::string body;
+
+    SQLINTEGER negative = -1;
+    EXPECT_THROW(writer.writeValue(0, makeBinding(SQL_C_SLONG, negative), body), SqlException);
+
+    SQLLEN null_ind = SQL_NULL_DATA;
+    EXPECT_THROW(writer.writeValue(0, makeBinding(SQL_C_SLONG, negative, &null_ind), body), SqlException);
+
+    SQLDOUBLE fractional = -32768.9;
+    writer.writeValue(1, makeBinding(SQL_C_DOUBLE, fractional), body);
+    EXPECT_EQ(body, std::string("\x00\x80", 2));
+
+    SQLDOUBLE too_big = 32768.0;
+    EXPECT_THROW(writer.writeValue(1, makeBinding(SQL_C_DOUBLE, too_big), body), SqlException);
+
+    char code[] = "abc";
+    SQLLEN code_ind = SQL_NTS;
+    EXPECT_THROW(writer.writeValue(2, makeBinding(SQL_C_CHAR, code, &code_ind), body), SqlException);
+}
+
+TEST(RowBinaryWriter, RejectsNonexistentDates) {
+    RowBinaryWriter writer({
+        {"day", "Date", SQL_C_TYPE_DATE}
+    });
+
+    std::string body;
+
+    SQL_DATE_STRUCT leap_day{2024, 2, 29};
+    writer.writeValue(0, makeBinding(SQL_C_TYPE_DATE, leap_day), body);
+    EXPECT_EQ(body.size(), 2);
+
+    for (const auto & date : {SQL_DATE_STRUCT{2023, 2, 29}, SQL_DATE_STRUCT{2023, 2, 31}, SQL_DATE_STRUCT{2100, 2, 29}, SQL_DATE_STRUCT{2023, 4, 31}}) {
+        auto value = date;
+        try {
+            writer.writeValue(0, makeBinding(SQL_C_TYPE_DATE, value), body);
+            ADD_FAILURE() << "Accepted " << value.year << "-" << value.month << "-" << value.day;
+        }
+        catch (const SqlException & ex) {
+            EXPECT_EQ(ex.getSQLState(), "22007");
+        }
+    }
+}
+
+TEST(RowBinaryWriter, UnknownTypesAreSentAsNullableStrings) {
+    RowBinaryWriter writer({
+        {"id", "", SQL_C_SLONG},
+        {"name", "", SQL_C_CHAR}
+    });
+
+    EXPECT_EQ(
+        writer.buildInsertQuery("t"),
+        "INSERT INTO t (`id`, `name`) SELECT * FROM input('`id` Nullable(String), `name` Nullable(String)') FORMAT RowBinary"
+    );
+
+    SQLINTEGER id = 42;
+    SQLLEN null_ind = SQL_NULL_DATA;
+
+    std::string body;
+    writer.writeValue(0, makeBinding(SQL_C_SLONG, id), body);
+    writer.writeValue(1, makeBinding(SQL_C_SLONG, id, &null_ind), body);
+    EXPECT_EQ(body, std::string("\x00\x02" "42" "\x01", 5));
+}
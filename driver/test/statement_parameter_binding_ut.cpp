@@ -287,3 +287,172 @@ TEST_F(StatementBindingTest, FunctionLocate) {
     ASSERT_EQ(params["param_odbc_positional_2"], "haystack");
     ASSERT_EQ(params["param_odbc_positional_3"], "5");
 }
+
+TEST_F(StatementBindingTest, MultipartBody) {
+    prepare("select ?, ?");
+
+    std::string param_1(4096, 'x');
+    bind(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, param_1.data(), param_1.size(), NULL);
+
+    SQLLEN null_ind = SQL_NULL_DATA;
+    int param_2 = 0;
+    bind(2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &param_2, 0, &null_ind);
+
+    std::ostringstream body;
+    statement.writeMultipartHttpRequest(body, "BOUNDARY");
+    ASSERT_EQ(body.str(),
+        "--BOUNDARY\r\n"
+        "Content-Disposition: form-data; name=\"query\"\r\n"
+        "\r\n"
+        "select {odbc_positional_1:LowCardinality(String)}, {odbc_positional_2:Nullable(Int32)}\r\n"
+        "--BOUNDARY\r\n"
+        "Content-Disposition: form-data; name=\"param_odbc_positional_1\"\r\n"
+        "\r\n"
+        + param_1 + "\r\n"
+        "--BOUNDARY\r\n"
+        "Content-Disposition: form-data; name=\"param_odbc_positional_2\"\r\n"
+        "\r\n"
+        "\r\n"
+        "--BOUNDARY--\r\n"
+    );
+}
+
+TEST_F(StatementBindingTest, DataAtExecutionParamIsNotSentInAdvance) {
+    prepare("select ?, ?");
+
+    int param_1 = 1;
+    bind(1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &param_1, 0, NULL);
+
+    SQLLEN data_at_exec_ind = SQL_LEN_DATA_AT_EXEC(0);
+    bind(2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR, 0, 0, reinterpret_cast<SQLPOINTER>(2), 0, &data_at_exec_ind);
+
+    std::ostringstream body;
+    statement.writeMultipartHttpRequest(body, "BOUNDARY");
+    ASSERT_EQ(body.str(),
+        "--BOUNDARY\r\n"
+        "Content-Disposition: form-data; name=\"query\"\r\n"
+        "\r\n"
+        "select {odbc_positional_1:Nullable(Int32)}, {odbc_positional_2:String}\r\n"
+        "--BOUNDARY\r\n"
+        "Content-Disposition: form-data; name=\"param_odbc_positional_1\"\r\n"
+        "\r\n"
+        "1\r\n"
+        "--BOUNDARY--\r\n"
+    );
+
+    // No execution is waiting for data.
+    char data[] = "value";
+    ASSERT_THROW(statement.putData(data, SQL_NTS), SqlException);
+}
+
+TEST_F(StatementBindingTest, MarkersAreSubstitutedInPlace) {
+    const std::string query_text = "select ?, '?', @name, \"@quoted\" where x = ?";
+
+    for (int i = 0; i < 2; ++i) { // The second time, the query is taken from the connection's cache.
+        prepare(query_text);
+
+        SQLINTEGER int_value = 1;
+        SQLLEN int_len = sizeof(int_value);
+        bind(1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &int_value, 0, &int_len);
+        bind(2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &int_value, 0, &int_len);
+        bind(3, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &int_value, 0, &int_len);
+
+        auto [query, params] = execute();
+        ASSERT_EQ(query,
+            "select {odbc_positional_1:Nullable(Int32)}, '?', "
+            "{name:Nullable(Int32)}, \"@quoted\" "
+            "where x = {odbc_positional_3:Nullable(Int32)}");
+        ASSERT_EQ(params.size(), 3);
+        ASSERT_EQ(params["param_name"], "1");
+    }
+}
+
+TEST_F(StatementBindingTest, RowWiseBinding) {
+    prepare("select ?, ?");
+
+    struct Row {
+        SQLINTEGER id;
+        SQLLEN id_ind;
+        char name[8];
+        SQLLEN name_ind;
+    };
+
+    Row rows[2] = {
+        {1, 0, "a", SQL_NTS},
+        {2, 0, "bc", SQL_NTS}
+    };
+
+    bind(1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &rows[0].id, 0, &rows[0].id_ind);
+    bind(2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, rows[0].name, sizeof(rows[0].name), &rows[0].name_ind);
+
+    // The bind offset moves all the buffers of the first parameter set to the second row.
+    SQLULEN bind_offset = sizeof(Row);
+    auto & apd_desc = statement.getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
+    apd_desc.setAttr(SQL_DESC_BIND_TYPE, static_cast<SQLULEN>(sizeof(Row)));
+    apd_desc.setAttr(SQL_DESC_BIND_OFFSET_PTR, &bind_offset);
+
+    auto [query, params] = execute();
+    ASSERT_EQ(params.size(), 2);
+    ASSERT_EQ(params["param_odbc_positional_1"], "2");
+    ASSERT_EQ(params["param_odbc_positional_2"], "bc");
+}
+
+TEST_F(StatementBindingTest, InferredParamTypes) {
+    connection.infer_param_types = true;
+    connection.table_column_types.put("t", std::make_shared<const Connection::TableColumnTypes>(Connection::TableColumnTypes{
+        {"id", "Int64"},
+        {"name", "LowCardinality(Nullable(String))"},
+        {"ratio", "Decimal(9, 2)"},
+        {"small", "Int16"},
+        {"count", "UInt64"}
+    }));
+
+    prepare(
+        "SELECT * FROM t WHERE id >= ? AND `name`=? AND ratio < ? AND length(name) = ? AND "
+        "small = ? AND count = ? AND t.id - small = ? AND id = ? * 2"
+    );
+
+    SQLINTEGER id = 42;
+    char name[] = "abc";
+    SQLLEN name_len = SQL_NTS;
+    SQLDOUBLE ratio = 1.5;
+    SQLINTEGER length = 3;
+
+    bind(1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &id, 0, nullptr);
+    bind(2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR, 20, 0, name, sizeof(name), &name_len);
+    bind(3, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE, 0, 0, &ratio, 0, nullptr);
+
+    for (SQLUSMALLINT param_num = 4; param_num <= 8; ++param_num)
+        bind(param_num, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &length, 0, nullptr);
+
+    // A double is not sent as Decimal, its text representation might not be parsable as one. Neither are integers sent as
+    // narrower or unsigned types, nor are the operands of arithmetic operators taken for the compared column.
+    auto [query, params] = execute();
+    ASSERT_EQ(query,
+        "SELECT * FROM t WHERE "
+        "id >= {odbc_positional_1:Int64} AND "
+        "`name`={odbc_positional_2:Nullable(String)} AND "
+        "ratio < {odbc_positional_3:Nullable(Float64)} AND "
+        "length(name) = {odbc_positional_4:Nullable(Int32)} AND "
+        "small = {odbc_positional_5:Nullable(Int32)} AND "
+        "count = {odbc_positional_6:Nullable(Int32)} AND "
+        "t.id - small = {odbc_positional_7:Nullable(Int32)} AND "
+        "id = {odbc_positional_8:Nullable(Int32)} * 2");
+
+    SQLSMALLINT data_type = 0;
+    SQLULEN size = 0;
+    SQLSMALLINT digits = 0;
+    SQLSMALLINT nullable = 0;
+
+    ASSERT_TRUE(SQL_SUCCEEDED(impl::DescribeParam(&statement, 1, &data_type, &size, &digits, &nullable)));
+    EXPECT_EQ(data_type, SQL_BIGINT);
+    EXPECT_EQ(nullable, SQL_NO_NULLS);
+
+    ASSERT_TRUE(SQL_SUCCEEDED(impl::DescribeParam(&statement, 2, &data_type, &size, &digits, &nullable)));
+    EXPECT_EQ(data_type, SQL_VARCHAR);
+    EXPECT_EQ(nullable, SQL_NULLABLE);
+
+    ASSERT_TRUE(SQL_SUCCEEDED(impl::DescribeParam(&statement, 3, &data_type, &size, &digits, &nullable)));
+    EXPECT_EQ(data_type, SQL_DECIMAL);
+    EXPECT_EQ(digits, 2);
+}
@@ -47,10 +47,16 @@ protected:
 using StringPongGUIDSymmetric     = StringPongSymmetric<SQLGUID>;
 using StringPongNumericSymmetric  = StringPongSymmetric<SQL_NUMERIC_STRUCT>;
 using StringPongNumericAsymmetric = StringPongAsymmetric<SQL_NUMERIC_STRUCT>;
+using StringPongDateAsymmetric      = StringPongAsymmetric<SQL_DATE_STRUCT>;
+using StringPongTimestampSymmetric  = StringPongSymmetric<SQL_TIMESTAMP_STRUCT>;
+using StringPongTimestampAsymmetric = StringPongAsymmetric<SQL_TIMESTAMP_STRUCT>;
 
 TEST_P(StringPongGUIDSymmetric,     Compare) { compare<DataType>(GetParam(), GetParam(), false/* case_sensitive */); }
 TEST_P(StringPongNumericSymmetric,  Compare) { compare<DataType>(GetParam(), GetParam()); }
 TEST_P(StringPongNumericAsymmetric, Compare) { compare<DataType>(std::get<0>(GetParam()), std::get<1>(GetParam())); }
+TEST_P(StringPongDateAsymmetric,      Compare) { compare<DataType>(std::get<0>(GetParam()), std::get<1>(GetParam())); }
+TEST_P(StringPongTimestampSymmetric,  Compare) { compare<DataType>(GetParam(), GetParam()); }
+TEST_P(StringPongTimestampAsymmetric, Compare) { compare<DataType>(std::get<0>(GetParam()), std::get<1>(GetParam())); }
 
 INSTANTIATE_TEST_SUITE_P(TypeConversion, StringPongGUIDSymmetric,
     ::testing::Values(
@@ -100,3 +106,205 @@ INSTANTIATE_TEST_SUITE_P(TypeConversion, StringPongNumericAsymmetric,
         { "000000.123", ".123" }
     })
 );
+
+INSTANTIATE_TEST_SUITE_P(TypeConversionWide, StringPongNumericSymmetric,
+    ::testing::Values(
+        "18446744073709551616",
+        "-18446744073709551616",
+        "99999999999999999999999999999999999999",
+        "-99999999999999999999999999999999999999",
+        ".99999999999999999999999999999999999999",
+        "1234567890123456789012345678.0123456789",
+        "-1234567890123456789012345678.0123456789",
+        "340282366920938463463374607431768211455"
+    )
+);
+
+class NumericRescale
+    : public ::testing::TestWithParam<std::tuple<std::string, int, int, std::string>>
+{
+};
+
+TEST_P(NumericRescale, Compare) {
+    const auto & [initial_str, precision, scale, expected_str] = GetParam();
+
+    SQL_NUMERIC_STRUCT src;
+    value_manip::to_null(src);
+    value_manip::from_value<std::string>::template to_value<SQL_NUMERIC_STRUCT>::convert(initial_str, src);
+
+    SQL_NUMERIC_STRUCT dest;
+    value_manip::to_null(dest);
+    dest.precision = precision;
+    dest.scale = scale;
+    value_manip::from_value<SQL_NUMERIC_STRUCT>::template to_value<SQL_NUMERIC_STRUCT>::convert(src, dest);
+
+    std::string resulting_str;
+    value_manip::from_value<SQL_NUMERIC_STRUCT>::template to_value<std::string>::convert(dest, resulting_str);
+
+    ASSERT_STREQ(resulting_str.c_str(), expected_str.c_str());
+}
+
+INSTANTIATE_TEST_SUITE_P(TypeConversion, NumericRescale,
+    ::testing::ValuesIn(std::initializer_list<std::tuple<std::string, int, int, std::string>>{
+        { "12345.6789", 10, 2, "12345.67" },
+        { "-12345.6789", 12, 6, "-12345.678900" },
+        { "12345", 8, 3, "12345.000" },
+        { "-0.001", 5, 2, ".00" },
+        { "18446744073709551615", 25, 4, "18446744073709551615.0000" }
+    })
+);
+
+TEST(NumericRescale, Overflow) {
+    SQL_NUMERIC_STRUCT src;
+    value_manip::to_null(src);
+    value_manip::from_value<std::string>::template to_value<SQL_NUMERIC_STRUCT>::convert("12345.6789", src);
+
+    SQL_NUMERIC_STRUCT dest;
+    value_manip::to_null(dest);
+    dest.precision = 6;
+    dest.scale = 2;
+
+    ASSERT_THROW((value_manip::from_value<SQL_NUMERIC_STRUCT>::template to_value<SQL_NUMERIC_STRUCT>::convert(src, dest)), std::runtime_error);
+}
+
+TEST(NumericFromInteger, Compare) {
+    const std::int64_t values[] = { 0, 1, -1, 1234567890, (std::numeric_limits<std::int64_t>::min)(), (std::numeric_limits<std::int64_t>::max)() };
+
+    for (const auto value : values) {
+        SQL_NUMERIC_STRUCT numeric;
+        value_manip::to_null(numeric);
+        value_manip::from_value<std::int64_t>::template to_value<SQL_NUMERIC_STRUCT>::convert(value, numeric);
+
+        std::string resulting_str;
+        value_manip::from_value<SQL_NUMERIC_STRUCT>::template to_value<std::string>::convert(numeric, resulting_str);
+        ASSERT_STREQ(resulting_str.c_str(), std::to_string(value).c_str());
+
+        std::int64_t resulting_value = 0;
+        value_manip::from_value<SQL_NUMERIC_STRUCT>::template to_value<std::int64_t>::convert(numeric, resulting_value);
+        ASSERT_EQ(resulting_value, value);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(TypeConversion, StringPongDateAsymmetric,
+    ::testing::ValuesIn(std::initializer_list<std::tuple<std::string, std::string>>{
+        { "2020-02-29", "2020-02-29" },
+        { "0000-00-00", "1970-01-01" },
+        { "1999-12-31 23:59:59", "1999-12-31" },
+        { "2106-02-07 06:28:15.123456789", "2106-02-07" }
+    })
+);
+
+INSTANTIATE_TEST_SUITE_P(TypeConversion, StringPongTimestampSymmetric,
+    ::testing::Values(
+        "1970-01-01 00:00:00",
+        "1999-12-31 23:59:59",
+        "2020-02-29 12:34:56.000000001",
+        "2106-02-07 06:28:15.999999999"
+    )
+);
+
+INSTANTIATE_TEST_SUITE_P(TypeConversion, StringPongTimestampAsymmetric,
+    ::testing::ValuesIn(std::initializer_list<std::tuple<std::string, std::string>>{
+        { "2020-02-29", "2020-02-29 00:00:00" },
+        { "0000-00-00 00:00:00", "1970-01-01 00:00:00" },
+        { "2020-02-29 12:34:56.", "2020-02-29 12:34:56" },
+        { "2020-02-29 12:34:56.000", "2020-02-29 12:34:56" },
+        { "2020-02-29 12:34:56.5", "2020-02-29 12:34:56.500000000" },
+        { "2020-02-29 12:34:56.123456", "2020-02-29 12:34:56.123456000" }
+    })
+);
+
+TEST(DateTimeParse, InvalidLayout) {
+    const std::string values[] = { "", "2020-02-2", "2020/02/29", "2020-02-29T12:34:56", "2020-02-29 12:34:5x", "2020-02-29 12:34:56.1234567890" };
+
+    for (const auto & value : values) {
+        SQL_TIMESTAMP_STRUCT timestamp;
+        ASSERT_THROW((value_manip::from_value<std::string>::template to_value<SQL_TIMESTAMP_STRUCT>::convert(value, timestamp)), std::runtime_error) << value;
+    }
+}
+
+TEST(DateTimeCivil, RoundTrip) {
+    for (std::int64_t days = -800000; days <= 800000; days += 7) {
+        SQL_DATE_STRUCT date;
+        value_manip::datetime::civilFromDays(days, date);
+        ASSERT_EQ(value_manip::datetime::daysFromCivil(date.year, date.month, date.day), days);
+    }
+
+    static_assert(value_manip::datetime::daysFromCivil(1970, 1, 1) == 0);
+    static_assert(value_manip::datetime::daysFromCivil(2000, 3, 1) == 11017);
+    static_assert(value_manip::datetime::daysFromCivil(1969, 12, 31) == -1);
+}
+
+TEST(DateTimeCivil, DateFromWire) {
+    const std::string timezone;
+    WireTypeDateAsInt src(timezone);
+    src.value = 18321; // 2020-02-29
+
+    SQL_DATE_STRUCT date;
+    value_manip::from_value<WireTypeDateAsInt>::template to_value<SQL_DATE_STRUCT>::convert(src, date);
+    ASSERT_EQ(date.year, 2020);
+    ASSERT_EQ(date.month, 2);
+    ASSERT_EQ(date.day, 29);
+}
+
+TEST(ConversionDispatch, CTypeOrdinal) {
+    using namespace value_manip::dispatch;
+
+    static_assert(getCTypeOrdinal(SQL_C_CHAR) == getCTypeOrdinal(SQL_C_BINARY));
+    static_assert(getCTypeOrdinal(SQL_C_BIT) == getCTypeOrdinal(SQL_C_UTINYINT));
+    static_assert(getCTypeOrdinal(SQL_C_TINYINT) == getCTypeOrdinal(SQL_C_STINYINT));
+    static_assert(getCTypeOrdinal(SQL_C_DATE) == getCTypeOrdinal(SQL_C_TYPE_DATE));
+    static_assert(getCTypeOrdinal(SQL_C_TIMESTAMP) == getCTypeOrdinal(SQL_C_TYPE_TIMESTAMP));
+    static_assert(getCTypeOrdinal(SQL_C_SBIGINT) == c_type_ordinal_of<SQLBIGINT>);
+    static_assert(getCTypeOrdinal(SQL_C_DEFAULT) == c_type_unsupported);
+
+    BindingInfo binding_info;
+    binding_info.c_type = SQL_C_DEFAULT;
+
+    std::int32_t value = 0;
+    ASSERT_THROW(writeDataFrom(value, binding_info, DefaultConversionContext{}), std::runtime_error);
+    ASSERT_THROW(readReadyDataTo(binding_info, value), std::runtime_error);
+}
+
+TEST(ConversionDispatch, VariantMatchesScalar) {
+    using Variant = std::variant<DataSourceType<DataSourceTypeId::Nothing>, DataSourceType<DataSourceTypeId::Int32>, DataSourceType<DataSourceTypeId::String>>;
+
+    DataSourceType<DataSourceTypeId::Int32> number;
+    number.value = -12345;
+
+    DataSourceType<DataSourceTypeId::String> string;
+    string.value = "-12345";
+
+    for (const auto c_type : { SQL_C_SLONG, SQL_C_DOUBLE, SQL_C_CHAR }) {
+        for (const Variant & src : { Variant{number}, Variant{string} }) {
+            char scalar_buffer[64] = {};
+            char variant_buffer[64] = {};
+            SQLLEN scalar_indicator = 0;
+            SQLLEN variant_indicator = 0;
+
+            BindingInfo scalar_binding_info;
+            scalar_binding_info.c_type = c_type;
+            scalar_binding_info.value = scalar_buffer;
+            scalar_binding_info.value_max_size = sizeof(scalar_buffer);
+            scalar_binding_info.indicator = &scalar_indicator;
+
+            BindingInfo variant_binding_info = scalar_binding_info;
+            variant_binding_info.value = variant_buffer;
+            variant_binding_info.indicator = &variant_indicator;
+
+            std::visit([&] (const auto & value) { writeDataFrom(value, scalar_binding_info, DefaultConversionContext{}); }, src);
+            writeDataFrom(src, variant_binding_info, DefaultConversionContext{});
+
+            ASSERT_EQ(std::memcmp(scalar_buffer, variant_buffer, sizeof(scalar_buffer)), 0) << c_type;
+            ASSERT_EQ(scalar_indicator, variant_indicator) << c_type;
+        }
+
+        SQLLEN indicator = 0;
+        BindingInfo binding_info;
+        binding_info.c_type = c_type;
+        binding_info.indicator = &indicator;
+
+        writeDataFrom(Variant{}, binding_info, DefaultConversionContext{});
+        ASSERT_EQ(indicator, SQL_NULL_DATA) << c_type;
+    }
+}
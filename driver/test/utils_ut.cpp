@@ -1,8 +1,24 @@
 #include "driver/utils/sql_encoding.h"
 #include "driver/utils/utils.h"
+#include "driver/utils/conversion.h"
+#include "driver/utils/amortized_istream_reader.h"
+#include "driver/utils/compression.h"
+#include "driver/utils/host_pool.h"
+#include "driver/utils/lru_cache.h"
+#include "driver/utils/retry_policy.h"
+#include "driver/utils/uint128.h"
+
+#include <Poco/InflatingStream.h>
+#include <Poco/StreamCopier.h>
+
+#include <lz4frame.h>
 
 #include <gtest/gtest.h>
 
+#include <random>
+#include <sstream>
+#include <vector>
+
 using values_t = std::set<std::string>;
 
 class ParseToSet
@@ -101,3 +117,510 @@ TEST(Escaping, ToSqlQuery)
     ASSERT_EQ(toSqlQueryValue(std::optional<int64_t>{}), "NULL");
     ASSERT_EQ(toSqlQueryValue(std::optional<uint64_t>{}), "NULL");
 }
+
+TEST(UnicodeConversion, RoundTrip) {
+    const std::string src = "Hello, \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82!";
+
+    for (int i = 0; i < 3; ++i) { // Repeat to exercise the reuse of the cached converters and buffers.
+        const auto wide = fromUTF8<char16_t>(src);
+        ASSERT_EQ(wide, u"Hello, \u041F\u0440\u0438\u0432\u0435\u0442!");
+        ASSERT_EQ(toUTF8(wide), src);
+        ASSERT_EQ(fromUTF8<char>(src), src);
+    }
+
+#if defined(WORKAROUND_USE_ICU)
+    // Signatures/BOMs are trimmed from the results.
+    UnicodeConversionContext context;
+    ASSERT_EQ(toUTF8(std::u16string{u"\uFEFFabc"}, context), "abc");
+    ASSERT_EQ(fromUTF8<char16_t>(std::string{"\xEF\xBB\xBF" "abc"}, context), u"abc");
+#endif
+}
+
+TEST(Compression, ParseMethod) {
+    CompressionMethod method = CompressionMethod::LZ4;
+    ASSERT_TRUE(tryParseCompressionMethod("", method));
+    ASSERT_EQ(method, CompressionMethod::None);
+    ASSERT_TRUE(tryParseCompressionMethod("off", method));
+    ASSERT_EQ(method, CompressionMethod::None);
+    ASSERT_TRUE(tryParseCompressionMethod("on", method));
+    ASSERT_EQ(method, CompressionMethod::Gzip);
+    ASSERT_TRUE(tryParseCompressionMethod("Deflate", method));
+    ASSERT_EQ(method, CompressionMethod::Deflate);
+    ASSERT_TRUE(tryParseCompressionMethod("LZ4", method));
+    ASSERT_EQ(method, CompressionMethod::LZ4);
+    ASSERT_FALSE(tryParseCompressionMethod("zstd", method));
+}
+
+TEST(Compression, RoundTrip) {
+    std::string src = "SELECT * FROM table WHERE id IN (";
+    for (int i = 0; i < 100000; ++i) {
+        src += std::to_string(i * 7);
+        src += ", ";
+    }
+    src += "0)";
+
+    for (const auto method : { CompressionMethod::Gzip, CompressionMethod::Deflate, CompressionMethod::LZ4 }) {
+        std::stringstream compressed;
+        CompressingOutputStream out(compressed, method);
+        out << src;
+        out.close();
+
+        const auto compressed_str = compressed.str();
+        ASSERT_LT(compressed_str.size(), src.size()) << getContentEncoding(method);
+
+        std::string decompressed;
+        if (method == CompressionMethod::LZ4) {
+            LZ4F_dctx * context = nullptr;
+            ASSERT_FALSE(LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION)));
+
+            std::size_t offset = 0;
+            std::string buffer(64 * 1024, '\0');
+            while (offset < compressed_str.size()) {
+                std::size_t dst_size = buffer.size();
+                std::size_t src_size = compressed_str.size() - offset;
+                const auto res = LZ4F_decompress(context, buffer.data(), &dst_size, compressed_str.data() + offset, &src_size, nullptr);
+                ASSERT_FALSE(LZ4F_isError(res));
+                decompressed.append(buffer.data(), dst_size);
+                offset += src_size;
+            }
+
+            LZ4F_freeDecompressionContext(context);
+        }
+        else {
+            Poco::InflatingInputStream in(compressed, (method == CompressionMethod::Gzip ? Poco::InflatingStreamBuf::STREAM_GZIP : Poco::InflatingStreamBuf::STREAM_ZLIB));
+            Poco::StreamCopier::copyToString(in, decompressed);
+        }
+
+        ASSERT_EQ(decompressed, src) << getContentEncoding(method);
+    }
+}
+
+TEST(Compression, CompressedBlocks) {
+    std::vector<std::string> blocks;
+    for (std::size_t i = 0; i < 5; ++i) {
+        std::string block;
+        for (std::size_t j = 0; j < 10000 * i; ++j)
+            block += std::to_string(i * j % 997) + ";";
+        blocks.push_back(std::move(block)); // Includes an empty block.
+    }
+
+    std::string framed;
+    std::string expected;
+    for (const auto & block : blocks) {
+        writeCompressedBlock(framed, block.data(), block.size());
+        expected += block;
+    }
+
+    for (const bool prefetch : { false, true }) {
+        std::istringstream raw(framed);
+        CompressedBlockInputStream in(raw, prefetch);
+
+        std::string decompressed;
+        Poco::StreamCopier::copyToString(in, decompressed);
+        ASSERT_EQ(decompressed, expected);
+    }
+
+    // Corrupt a byte in the payload of the last block.
+    {
+        auto corrupted = framed;
+        corrupted[corrupted.size() - 3] ^= 0x20;
+
+        std::istringstream raw(corrupted);
+        CompressedBlockInputStream in(raw);
+        std::string decompressed;
+        ASSERT_THROW(Poco::StreamCopier::copyToString(in, decompressed), std::runtime_error);
+    }
+
+    // Truncate the last block.
+    {
+        std::istringstream raw(framed.substr(0, framed.size() - 1));
+        CompressedBlockInputStream in(raw);
+        std::string decompressed;
+        ASSERT_THROW(Poco::StreamCopier::copyToString(in, decompressed), std::runtime_error);
+    }
+}
+
+TEST(Compression, CompressedBlockKnownAnswers) {
+    // CityHash v1.0.2 (the version ClickHouse uses for the block checksums) of the empty input, from its reference test suite.
+    ASSERT_EQ(cityHash128("", 0), std::make_pair(std::uint64_t{0x3df09dfc64c09a2bULL}, std::uint64_t{0x3cb540c392e51e29ULL}));
+
+    // "1\n2\n3\n" in an LZ4 block and in an uncompressed block, byte for byte as they appear on the wire.
+    // These are pinned, so that a change in the checksum or the header layout can't go unnoticed by the round trip tests.
+    const std::string lz4_block(
+        "\xe9\x89\x95\xab\x0c\xd8\xd8\xbd\xca\x01\xcf\x3b\x27\xbf\x30\x58"
+        "\x82\x10\x00\x00\x00\x06\x00\x00\x00"
+        "\x60\x31\x0a\x32\x0a\x33\x0a", 32
+    );
+
+    const std::string plain_block(
+        "\x21\xcb\xe2\x5e\xe5\x8a\xb1\xab\x15\x93\x8b\xf3\x76\x3b\x67\x3b"
+        "\x02\x0f\x00\x00\x00\x06\x00\x00\x00"
+        "1\n2\n3\n", 31
+    );
+
+    std::string written;
+    writeCompressedBlock(written, "1\n2\n3\n", 6);
+    ASSERT_EQ(written, lz4_block);
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        { lz4_block, "1\n2\n3\n" },
+        { plain_block, "1\n2\n3\n" },
+        { lz4_block + plain_block, "1\n2\n3\n1\n2\n3\n" },
+    };
+
+    for (const auto & [framed, expected] : cases) {
+        std::istringstream raw(framed);
+        CompressedBlockInputStream in(raw);
+        std::string decompressed;
+        Poco::StreamCopier::copyToString(in, decompressed);
+        ASSERT_EQ(decompressed, expected);
+    }
+}
+
+TEST(Compression, ReadBlocksInPlace) {
+    std::string expected;
+    std::string framed;
+    for (std::size_t i = 0; i < 7; ++i) {
+        std::string block;
+        for (std::size_t j = 0; j < 1000 + 777 * i; ++j)
+            block += static_cast<char>('a' + (i + j) % 26);
+        writeCompressedBlock(framed, block.data(), block.size());
+        expected += block;
+    }
+
+    std::istringstream raw(framed);
+    CompressedBlockInputStream in(raw);
+    AmortizedIStreamReader reader(in);
+
+    // Mix single characters and reads of various sizes, so that some of them straddle the block boundaries.
+    std::string actual;
+    for (std::size_t i = 0; !reader.eof(); ++i) {
+        if (i % 3 == 0) {
+            actual += reader.get();
+        }
+        else {
+            std::string chunk(std::min<std::size_t>(i % 500, expected.size() - actual.size()), '\0');
+            reader.read(chunk.data(), chunk.size());
+            actual += chunk;
+        }
+    }
+
+    ASSERT_EQ(actual, expected);
+    ASSERT_THROW(reader.get(), std::runtime_error);
+}
+
+TEST(HostPool, ParseHostList) {
+    std::vector<HostPool::Endpoint> endpoints;
+
+    ASSERT_TRUE(tryParseHostList("localhost", 8123, endpoints));
+    ASSERT_EQ(endpoints.size(), 1);
+    EXPECT_EQ(endpoints[0].host, "localhost");
+    EXPECT_EQ(endpoints[0].port, 8123);
+
+    ASSERT_TRUE(tryParseHostList("ch1, ch2:8124,[::1]:9000,::1", 8123, endpoints));
+    ASSERT_EQ(endpoints.size(), 4);
+    EXPECT_EQ(endpoints[0].host, "ch1");
+    EXPECT_EQ(endpoints[0].port, 8123);
+    EXPECT_EQ(endpoints[1].host, "ch2");
+    EXPECT_EQ(endpoints[1].port, 8124);
+    EXPECT_EQ(endpoints[2].host, "::1");
+    EXPECT_EQ(endpoints[2].port, 9000);
+    EXPECT_EQ(endpoints[3].host, "::1");
+    EXPECT_EQ(endpoints[3].port, 8123);
+
+    EXPECT_FALSE(tryParseHostList("", 8123, endpoints));
+    EXPECT_FALSE(tryParseHostList("ch1,,ch2", 8123, endpoints));
+    EXPECT_FALSE(tryParseHostList("ch1:", 8123, endpoints));
+    EXPECT_FALSE(tryParseHostList("ch1:0", 8123, endpoints));
+    EXPECT_FALSE(tryParseHostList("ch1:65536", 8123, endpoints));
+    EXPECT_FALSE(tryParseHostList("[::1", 8123, endpoints));
+    EXPECT_FALSE(tryParseHostList("[::1]9000", 8123, endpoints));
+}
+
+TEST(HostPool, FailoverAndBackoff) {
+    HostPool pool;
+    pool.reset({{"ch1", 8123}, {"ch2", 8123}, {"ch3", 8123}});
+
+    const auto now = HostPool::Clock::now();
+
+    // The excluded endpoint is never picked while there are alternatives.
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_NE(pool.pick(0, now), 0);
+    }
+
+    // One failure doesn't put an endpoint into backoff, two do.
+    pool.reportFailure(1, now);
+    pool.reportFailure(2, now);
+    pool.reportFailure(2, now);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(pool.pick(0, now), 1);
+    }
+
+    // When all the alternatives are in backoff, the one that leaves it first is picked. The backoff grows with further failures.
+    pool.reportFailure(1, now);
+    pool.reportFailure(2, now);
+    EXPECT_EQ(pool.pick(0, now), 1);
+
+    // The backoff expires.
+    EXPECT_EQ(pool.pick(0, now + HostPool::min_backoff), 1);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_NE(pool.pick(HostPool::npos, now + HostPool::min_backoff), 2);
+    }
+
+    // A success resets the failure statistics.
+    pool.reportSuccess(1, std::chrono::milliseconds(1));
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(pool.pick(0, now), 1);
+    }
+}
+
+TEST(HostPool, PreferLowerLatency) {
+    HostPool pool;
+    pool.reset({{"slow", 8123}, {"fast", 8123}});
+
+    pool.reportSuccess(0, std::chrono::milliseconds(100));
+    pool.reportSuccess(1, std::chrono::milliseconds(5));
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(pool.pick(), 1);
+    }
+
+    // The latency estimate follows the recent samples.
+    for (int i = 0; i < 50; ++i) {
+        pool.reportSuccess(1, std::chrono::milliseconds(500));
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(pool.pick(), 0);
+    }
+}
+
+TEST(RetryPolicy, Backoff) {
+    RetryPolicy policy;
+    policy.base_backoff = std::chrono::milliseconds(100);
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_LE(policy.getBackoff(1), std::chrono::milliseconds(100));
+        EXPECT_LE(policy.getBackoff(3), std::chrono::milliseconds(400));
+        EXPECT_LE(policy.getBackoff(50), RetryPolicy::max_backoff);
+        EXPECT_GE(policy.getBackoff(50), RetryPolicy::Clock::duration::zero());
+    }
+
+    policy.base_backoff = RetryPolicy::Clock::duration::zero();
+    EXPECT_EQ(policy.getBackoff(5), RetryPolicy::Clock::duration::zero());
+}
+
+TEST(RetryPolicy, FailureAction) {
+    RetryPolicy policy;
+    policy.max_retries = 2;
+
+    RequestFailure connect_timeout;
+    connect_timeout.timeout = true;
+    connect_timeout.no_response = true;
+
+    RequestFailure receive_timeout;
+    receive_timeout.timeout = true;
+    receive_timeout.request_sent = true;
+
+    RequestFailure connection_reset;
+    connection_reset.request_sent = true;
+
+    RequestFailure no_message;
+    no_message.request_sent = true;
+    no_message.no_response = true;
+
+    // An unresponsive endpoint is failed over from, even if a query timeout is set, and even for non-idempotent queries,
+    // as long as the request hasn't been sent.
+    EXPECT_EQ(policy.getFailureAction(1, connect_timeout, false, true), FailureAction::Retry);
+    EXPECT_EQ(policy.getFailureAction(1, connect_timeout, false, false), FailureAction::Retry);
+    EXPECT_EQ(policy.getFailureAction(3, connect_timeout, true, false), FailureAction::Fail);
+
+    // Waiting for the response is limited by the query timeout, if any, and by the receive timeout of the connection otherwise.
+    EXPECT_EQ(policy.getFailureAction(1, receive_timeout, true, true), FailureAction::QueryTimeout);
+    EXPECT_EQ(policy.getFailureAction(3, receive_timeout, true, true), FailureAction::QueryTimeout);
+    EXPECT_EQ(policy.getFailureAction(1, receive_timeout, true, false), FailureAction::Retry);
+    EXPECT_EQ(policy.getFailureAction(1, receive_timeout, false, false), FailureAction::Fail);
+
+    EXPECT_EQ(policy.getFailureAction(2, connection_reset, true, true), FailureAction::Retry);
+    EXPECT_EQ(policy.getFailureAction(1, connection_reset, false, false), FailureAction::Fail);
+    EXPECT_EQ(policy.getFailureAction(1, no_message, false, true), FailureAction::Retry);
+}
+
+TEST(RetryPolicy, ResponseAction) {
+    RetryPolicy policy;
+    policy.max_retries = 2;
+
+    const auto ok = policy.getResponseAction(1, 200);
+    EXPECT_FALSE(ok.endpoint_failed);
+    EXPECT_FALSE(ok.trip_breaker);
+    EXPECT_FALSE(ok.retry);
+
+    // Errors of the query are not failures of the endpoint.
+    EXPECT_FALSE(policy.getResponseAction(1, 500).endpoint_failed);
+    EXPECT_FALSE(policy.getResponseAction(3, 404).endpoint_failed);
+
+    const auto unavailable = policy.getResponseAction(2, 503);
+    EXPECT_TRUE(unavailable.endpoint_failed);
+    EXPECT_TRUE(unavailable.trip_breaker);
+    EXPECT_TRUE(unavailable.retry);
+
+    const auto throttled = policy.getResponseAction(1, 429);
+    EXPECT_TRUE(throttled.endpoint_failed);
+    EXPECT_FALSE(throttled.trip_breaker);
+    EXPECT_TRUE(throttled.retry);
+
+    // The rejection of the last attempt is still a failure of the endpoint, it is just not retried.
+    const auto last_unavailable = policy.getResponseAction(3, 503);
+    EXPECT_TRUE(last_unavailable.endpoint_failed);
+    EXPECT_TRUE(last_unavailable.trip_breaker);
+    EXPECT_FALSE(last_unavailable.retry);
+
+    const auto last_throttled = policy.getResponseAction(3, 429);
+    EXPECT_TRUE(last_throttled.endpoint_failed);
+    EXPECT_FALSE(last_throttled.trip_breaker);
+    EXPECT_FALSE(last_throttled.retry);
+}
+
+TEST(RetryPolicy, IdempotentQuery) {
+    EXPECT_TRUE(isIdempotentQuery("SELECT 1"));
+    EXPECT_TRUE(isIdempotentQuery("  select 1"));
+    EXPECT_TRUE(isIdempotentQuery("(SELECT 1) UNION ALL (SELECT 2)"));
+    EXPECT_TRUE(isIdempotentQuery("-- comment\n/* another\ncomment */ WITH 1 AS x SELECT x"));
+    EXPECT_TRUE(isIdempotentQuery("SHOW TABLES"));
+    EXPECT_TRUE(isIdempotentQuery("DESC t"));
+    EXPECT_FALSE(isIdempotentQuery("INSERT INTO t VALUES (1)"));
+    EXPECT_FALSE(isIdempotentQuery("SELECTED"));
+    EXPECT_FALSE(isIdempotentQuery("ALTER TABLE t DELETE WHERE 1"));
+    EXPECT_FALSE(isIdempotentQuery("/* SELECT */ DROP TABLE t"));
+    EXPECT_FALSE(isIdempotentQuery("-- SELECT"));
+    EXPECT_FALSE(isIdempotentQuery(""));
+}
+
+TEST(RetryPolicy, ParseRetryAfter) {
+    RetryPolicy::Clock::duration delay;
+
+    ASSERT_TRUE(tryParseRetryAfter(" 5 ", delay));
+    EXPECT_EQ(delay, std::chrono::seconds(5));
+
+    ASSERT_TRUE(tryParseRetryAfter("Wed, 21 Oct 2015 07:28:00 GMT", delay)); // In the past.
+    EXPECT_EQ(delay, RetryPolicy::Clock::duration::zero());
+
+    EXPECT_FALSE(tryParseRetryAfter("", delay));
+    EXPECT_FALSE(tryParseRetryAfter("soon", delay));
+}
+
+TEST(RetryPolicy, CircuitBreaker) {
+    CircuitBreaker breaker;
+    const auto now = CircuitBreaker::Clock::now();
+
+    for (unsigned int i = 1; i < CircuitBreaker::failure_threshold; ++i) {
+        breaker.reportFailure(now);
+        EXPECT_TRUE(breaker.allowRequest(now));
+    }
+
+    breaker.reportFailure(now);
+    EXPECT_FALSE(breaker.allowRequest(now));
+
+    // Half-open: a single trial request per period.
+    const auto later = now + CircuitBreaker::open_duration;
+    EXPECT_TRUE(breaker.allowRequest(later));
+    EXPECT_FALSE(breaker.allowRequest(later));
+
+    breaker.reportSuccess();
+    EXPECT_TRUE(breaker.allowRequest(later));
+
+    EXPECT_EQ(&CircuitBreaker::forEndpoint("ch1", 8123), &CircuitBreaker::forEndpoint("ch1", 8123));
+    EXPECT_NE(&CircuitBreaker::forEndpoint("ch1", 8123), &CircuitBreaker::forEndpoint("ch1", 8124));
+}
+
+TEST(LRUCache, EvictsLeastRecentlyUsed) {
+    LRUCache<std::string, int> cache(2);
+    int value = 0;
+
+    cache.put("a", 1);
+    cache.put("b", 2);
+    EXPECT_TRUE(cache.tryGet("a", value));
+    EXPECT_EQ(value, 1);
+
+    // "b" is the least recently used one now.
+    cache.put("c", 3);
+    EXPECT_EQ(cache.getSize(), 2);
+    EXPECT_FALSE(cache.tryGet("b", value));
+    EXPECT_TRUE(cache.tryGet("a", value));
+    EXPECT_TRUE(cache.tryGet("c", value));
+    EXPECT_EQ(value, 3);
+
+    cache.put("a", 10);
+    cache.put("d", 4);
+    EXPECT_FALSE(cache.tryGet("c", value));
+    EXPECT_TRUE(cache.tryGet("a", value));
+    EXPECT_EQ(value, 10);
+
+    cache.clear();
+    EXPECT_EQ(cache.getSize(), 0);
+    EXPECT_FALSE(cache.tryGet("a", value));
+}
+
+TEST(UInt128, KnownAnswers) {
+    const UInt128 max = ~UInt128{0};
+    EXPECT_EQ(max, UInt128(0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull));
+    EXPECT_EQ(max + 1, UInt128{0});
+    EXPECT_EQ(UInt128{0} - 1, max);
+    EXPECT_EQ(UInt128{-1}, max);
+    EXPECT_EQ(-UInt128{5}, max - 4);
+
+    // 10^38, the biggest power of 10 that fits, and 2^128 - 1 in decimal digits.
+    UInt128 pow10 = 1;
+    for (int i = 0; i < 38; ++i)
+        pow10 *= 10;
+
+    EXPECT_EQ(pow10, UInt128(0x4B3B4CA85A86C47Aull, 0x098A224000000000ull));
+
+    std::string digits;
+    for (auto value = max; value != 0; value /= 10)
+        digits.insert(digits.begin(), static_cast<char>('0' + static_cast<int>(value % 10)));
+    EXPECT_EQ(digits, "340282366920938463463374607431768211455");
+
+    const UInt128 pow10_19 = 10000000000000000000ull;
+    EXPECT_EQ(max / pow10_19, UInt128(0x1ull, 0xD83C94FB6D2AC34Aull));
+    EXPECT_EQ(max % pow10_19, UInt128{3374607431768211455ull});
+    EXPECT_EQ(UInt128(1, 0) >> 1, UInt128{0x8000000000000000ull});
+    EXPECT_EQ(UInt128{1} << 127, UInt128(0x8000000000000000ull, 0));
+    EXPECT_EQ(static_cast<std::uint32_t>(UInt128(7, 0x100000005ull)), 5u);
+    EXPECT_EQ(static_cast<double>(UInt128(1, 0)), 18446744073709551616.0);
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(UInt128, MatchesNativeInt128) {
+    std::mt19937_64 rng(42);
+
+    const auto to_native = [] (const UInt128 & value) {
+        return (static_cast<unsigned __int128>(value.high) << 64) | value.low;
+    };
+
+    // Values of mixed widths, so that both the 32-bit and the binary long division are exercised.
+    const auto random_value = [&] () {
+        const auto bits = static_cast<unsigned int>(rng() % 129);
+        const UInt128 value(rng(), rng());
+        return (bits == 0 ? UInt128{0} : value >> (128 - bits));
+    };
+
+    for (int i = 0; i < 10000; ++i) {
+        const auto left = random_value();
+        const auto right = random_value();
+        const auto shift = static_cast<unsigned int>(rng() % 128);
+
+        ASSERT_EQ(to_native(left + right), to_native(left) + to_native(right));
+        ASSERT_EQ(to_native(left - right), to_native(left) - to_native(right));
+        ASSERT_EQ(to_native(left * right), to_native(left) * to_native(right));
+        ASSERT_EQ(to_native(left << shift), to_native(left) << shift);
+        ASSERT_EQ(to_native(left >> shift), to_native(left) >> shift);
+        ASSERT_EQ(left < right, to_native(left) < to_native(right));
+
+        if (right != 0) {
+            ASSERT_EQ(to_native(left / right), to_native(left) / to_native(right));
+            ASSERT_EQ(to_native(left % right), to_native(left) % to_native(right));
+        }
+    }
+}
+#endif
@@ -2,32 +2,59 @@
 
 #include "driver/platform/platform.h"
 #include "driver/utils/resize_without_initialization.h"
+#include "driver/utils/string_view.h"
 
 #include <algorithm>
 #include <istream>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
 
 #include <cstring>
 
+// A stream buffer that lets AmortizedIStreamReader parse the characters of its get area in place,
+// instead of copying them into the reader's own buffer first. Suitable for stream buffers that hand out large blocks of data.
+class ContiguousStreamBuf
+    : public std::streambuf
+{
+public:
+    // Return the characters of the get area, refilling it first if it is empty. Empty view means the end of the stream.
+    StringView peekContiguous() {
+        if (gptr() == egptr() && traits_type::eq_int_type(underflow(), traits_type::eof()))
+            return StringView{};
+
+        return StringView(gptr(), egptr());
+    }
+
+    void consumeContiguous(std::size_t count) {
+        gbump(static_cast<int>(count));
+    }
+};
+
 // A restricted wrapper around std::istream, that tries to reduce the number of std::istream::read() calls at the cost of extra std::memcpy().
 // Maintains internal buffer of pre-read characters making AmortizedIStreamReader::read() calls for small counts more efficient.
+// If the stream buffer of the underlying stream is a ContiguousStreamBuf, reads are served directly from its get area,
+// and only the values that straddle the boundary of its blocks go through the internal buffer.
 // Handles incomplete reads and terminated std::istream more aggressively, by throwing exceptions.
 class AmortizedIStreamReader
 {
 public:
     explicit AmortizedIStreamReader(std::istream & raw_stream)
         : raw_stream_(raw_stream)
+        , contiguous_buf_(dynamic_cast<ContiguousStreamBuf *>(raw_stream.rdbuf()))
     {
     }
 
     ~AmortizedIStreamReader() {
         // Put back any pre-read characters, just in case...
-        if (available() > 0) {
-            for (std::size_t i = buffer_.size() - 1; i >= offset_; --i) {
-                raw_stream_.putback(buffer_[i]);
+        // The underlying stream may be configured to throw, so make sure nothing escapes from here.
+        try {
+            for (std::size_t i = buffer_.size(); i > offset_; --i) {
+                raw_stream_.putback(buffer_[i - 1]);
             }
         }
+        catch (...) {
+        }
     }
 
     AmortizedIStreamReader(const AmortizedIStreamReader &) = delete;
@@ -39,6 +66,9 @@ public:
         if (available() > 0)
             return false;
 
+        if (contiguous_buf_)
+            return contiguous_buf_->peekContiguous().empty();
+
         if (raw_stream_.eof() || raw_stream_.fail())
             return true;
 
@@ -51,6 +81,14 @@ public:
     }
 
     char get() {
+        if (available() == 0 && contiguous_buf_) {
+            const auto view = contiguous_buf_->peekContiguous();
+            if (!view.empty()) {
+                contiguous_buf_->consumeContiguous(1);
+                return view[0];
+            }
+        }
+
         tryPrepare(1);
 
         if (available() < 1)
@@ -60,6 +98,17 @@ public:
     }
 
     AmortizedIStreamReader & read(char * str, std::size_t count) {
+        if (available() == 0 && contiguous_buf_) {
+            const auto view = contiguous_buf_->peekContiguous();
+            if (view.size() >= count) {
+                if (str)
+                    std::memcpy(str, view.data(), count);
+
+                contiguous_buf_->consumeContiguous(count);
+                return *this;
+            }
+        }
+
         tryPrepare(count);
 
         if (available() < count)
@@ -123,6 +172,7 @@ private:
 
 private:
     std::istream & raw_stream_;
+    ContiguousStreamBuf * contiguous_buf_ = nullptr;
     std::size_t offset_ = 0;
     std::string buffer_;
 };
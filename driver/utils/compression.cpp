@@ -0,0 +1,515 @@
+#include "driver/utils/compression.h"
+#include "driver/utils/utils.h"
+#include "driver/utils/resize_without_initialization.h"
+
+#include <Poco/ByteOrder.h>
+#include <Poco/UTF8String.h>
+
+#include <lz4.h>
+#include <lz4frame.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <cstring>
+
+bool tryParseCompressionMethod(const std::string & name, CompressionMethod & method) {
+    if (name.empty() || Poco::UTF8::icompare(name, "none") == 0 || (isYesOrNo(name) && !isYes(name)))
+        method = CompressionMethod::None;
+    else if (Poco::UTF8::icompare(name, "gzip") == 0 || isYes(name))
+        method = CompressionMethod::Gzip;
+    else if (Poco::UTF8::icompare(name, "deflate") == 0)
+        method = CompressionMethod::Deflate;
+    else if (Poco::UTF8::icompare(name, "lz4") == 0)
+        method = CompressionMethod::LZ4;
+    else
+        return false;
+
+    return true;
+}
+
+std::string getContentEncoding(CompressionMethod method) {
+    switch (method) {
+        case CompressionMethod::None:    return "";
+        case CompressionMethod::Gzip:    return "gzip";
+        case CompressionMethod::Deflate: return "deflate";
+        case CompressionMethod::LZ4:     return "lz4";
+    }
+
+    throw std::runtime_error("Unknown compression method");
+}
+
+namespace {
+
+void throwOnLZ4FError(std::size_t code) {
+    if (LZ4F_isError(code))
+        throw std::runtime_error(std::string("LZ4 compression failed: ") + LZ4F_getErrorName(code));
+}
+
+} // namespace
+
+LZ4FrameStreamBuf::LZ4FrameStreamBuf(std::ostream & out_)
+    : Poco::BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out)
+    , out(&out_)
+{
+    throwOnLZ4FError(LZ4F_createCompressionContext(&context, LZ4F_VERSION));
+
+    // Large enough for the frame header, any single update of STREAM_BUFFER_SIZE bytes, and the frame end mark.
+    frame_buffer.resize(LZ4F_compressBound(STREAM_BUFFER_SIZE, nullptr) + LZ4F_HEADER_SIZE_MAX);
+
+    const auto size = LZ4F_compressBegin(context, frame_buffer.data(), frame_buffer.size(), nullptr);
+    throwOnLZ4FError(size);
+    writeOut(size);
+}
+
+LZ4FrameStreamBuf::~LZ4FrameStreamBuf() {
+    try {
+        close();
+    }
+    catch (...) {
+    }
+
+    LZ4F_freeCompressionContext(context);
+}
+
+void LZ4FrameStreamBuf::close() {
+    if (closed)
+        return;
+
+    closed = true;
+    sync();
+
+    const auto size = LZ4F_compressEnd(context, frame_buffer.data(), frame_buffer.size(), nullptr);
+    throwOnLZ4FError(size);
+    writeOut(size);
+    out->flush();
+}
+
+int LZ4FrameStreamBuf::writeToDevice(const char * buffer, std::streamsize length) {
+    if (length <= 0)
+        return 0;
+
+    try {
+        const auto size = LZ4F_compressUpdate(context, frame_buffer.data(), frame_buffer.size(), buffer, length, nullptr);
+        throwOnLZ4FError(size);
+        writeOut(size);
+    }
+    catch (...) {
+        return -1;
+    }
+
+    return static_cast<int>(length);
+}
+
+void LZ4FrameStreamBuf::writeOut(std::size_t size) {
+    if (size > 0 && !out->write(frame_buffer.data(), size))
+        throw std::runtime_error("Failed to write compressed data");
+}
+
+CompressingOutputStream::CompressingOutputStream(std::ostream & out, CompressionMethod method)
+    : std::ostream(nullptr)
+{
+    switch (method) {
+        case CompressionMethod::None:
+            rdbuf(out.rdbuf());
+            break;
+
+        case CompressionMethod::Gzip:
+            deflating_buf = std::make_unique<Poco::DeflatingStreamBuf>(out, Poco::DeflatingStreamBuf::STREAM_GZIP, Z_DEFAULT_COMPRESSION);
+            rdbuf(deflating_buf.get());
+            break;
+
+        case CompressionMethod::Deflate:
+            deflating_buf = std::make_unique<Poco::DeflatingStreamBuf>(out, Poco::DeflatingStreamBuf::STREAM_ZLIB, Z_DEFAULT_COMPRESSION);
+            rdbuf(deflating_buf.get());
+            break;
+
+        case CompressionMethod::LZ4:
+            lz4_buf = std::make_unique<LZ4FrameStreamBuf>(out);
+            rdbuf(lz4_buf.get());
+            break;
+    }
+}
+
+CompressingOutputStream::~CompressingOutputStream() {
+    rdbuf(nullptr);
+}
+
+void CompressingOutputStream::close() {
+    if (deflating_buf)
+        deflating_buf->close();
+    else if (lz4_buf)
+        lz4_buf->close();
+    else
+        flush();
+}
+
+namespace {
+
+namespace city {
+
+    using uint128 = std::pair<std::uint64_t, std::uint64_t>;
+
+    constexpr std::uint64_t k0 = 0xc3a5c85c97cb3127ULL;
+    constexpr std::uint64_t k1 = 0xb492b66fbe98f273ULL;
+    constexpr std::uint64_t k2 = 0x9ae16a3b2f90404fULL;
+    constexpr std::uint64_t k3 = 0xc949d7c7509e6557ULL;
+
+    inline std::uint64_t fetch64(const char * p) {
+        std::uint64_t result;
+        std::memcpy(&result, p, sizeof(result));
+        return Poco::ByteOrder::fromLittleEndian(result);
+    }
+
+    inline std::uint32_t fetch32(const char * p) {
+        std::uint32_t result;
+        std::memcpy(&result, p, sizeof(result));
+        return Poco::ByteOrder::fromLittleEndian(result);
+    }
+
+    inline std::uint64_t rotate(std::uint64_t val, int shift) {
+        return (shift == 0 ? val : ((val >> shift) | (val << (64 - shift))));
+    }
+
+    inline std::uint64_t rotateByAtLeast1(std::uint64_t val, int shift) {
+        return ((val >> shift) | (val << (64 - shift)));
+    }
+
+    inline std::uint64_t shiftMix(std::uint64_t val) {
+        return (val ^ (val >> 47));
+    }
+
+    inline std::uint64_t hash128to64(const uint128 & x) {
+        constexpr std::uint64_t mul = 0x9ddfea08eb382d69ULL;
+        std::uint64_t a = (x.first ^ x.second) * mul;
+        a ^= (a >> 47);
+        std::uint64_t b = (x.second ^ a) * mul;
+        b ^= (b >> 47);
+        b *= mul;
+        return b;
+    }
+
+    inline std::uint64_t hashLen16(std::uint64_t u, std::uint64_t v) {
+        return hash128to64(uint128(u, v));
+    }
+
+    std::uint64_t hashLen0to16(const char * s, std::size_t len) {
+        if (len > 8) {
+            const std::uint64_t a = fetch64(s);
+            const std::uint64_t b = fetch64(s + len - 8);
+            return hashLen16(a, rotateByAtLeast1(b + len, len)) ^ b;
+        }
+
+        if (len >= 4) {
+            const std::uint64_t a = fetch32(s);
+            return hashLen16(len + (a << 3), fetch32(s + len - 4));
+        }
+
+        if (len > 0) {
+            const std::uint8_t a = s[0];
+            const std::uint8_t b = s[len >> 1];
+            const std::uint8_t c = s[len - 1];
+            const std::uint32_t y = static_cast<std::uint32_t>(a) + (static_cast<std::uint32_t>(b) << 8);
+            const std::uint32_t z = len + (static_cast<std::uint32_t>(c) << 2);
+            return shiftMix(y * k2 ^ z * k3) * k2;
+        }
+
+        return k2;
+    }
+
+    inline uint128 weakHashLen32WithSeeds(std::uint64_t w, std::uint64_t x, std::uint64_t y, std::uint64_t z, std::uint64_t a, std::uint64_t b) {
+        a += w;
+        b = rotate(b + a + z, 21);
+        const std::uint64_t c = a;
+        a += x;
+        a += y;
+        b += rotate(a, 44);
+        return uint128(a + z, b + c);
+    }
+
+    inline uint128 weakHashLen32WithSeeds(const char * s, std::uint64_t a, std::uint64_t b) {
+        return weakHashLen32WithSeeds(fetch64(s), fetch64(s + 8), fetch64(s + 16), fetch64(s + 24), a, b);
+    }
+
+    uint128 cityMurmur(const char * s, std::size_t len, uint128 seed) {
+        std::uint64_t a = seed.first;
+        std::uint64_t b = seed.second;
+        std::uint64_t c = 0;
+        std::uint64_t d = 0;
+        std::int64_t l = static_cast<std::int64_t>(len) - 16;
+
+        if (l <= 0) {
+            a = shiftMix(a * k1) * k1;
+            c = b * k1 + hashLen0to16(s, len);
+            d = shiftMix(a + (len >= 8 ? fetch64(s) : c));
+        }
+        else {
+            c = hashLen16(fetch64(s + len - 8) + k1, a);
+            d = hashLen16(b + len, c + fetch64(s + len - 16));
+            a += d;
+            do {
+                a ^= shiftMix(fetch64(s) * k1) * k1;
+                a *= k1;
+                b ^= a;
+                c ^= shiftMix(fetch64(s + 8) * k1) * k1;
+                c *= k1;
+                d ^= c;
+                s += 16;
+                l -= 16;
+            } while (l > 0);
+        }
+
+        a = hashLen16(a, c);
+        b = hashLen16(d, b);
+        return uint128(a ^ b, hashLen16(b, a));
+    }
+
+    uint128 cityHash128WithSeed(const char * s, std::size_t len, uint128 seed) {
+        if (len < 128)
+            return cityMurmur(s, len, seed);
+
+        uint128 v;
+        uint128 w;
+        std::uint64_t x = seed.first;
+        std::uint64_t y = seed.second;
+        std::uint64_t z = len * k1;
+        v.first = rotate(y ^ k1, 49) * k1 + fetch64(s);
+        v.second = rotate(v.first, 42) * k1 + fetch64(s + 8);
+        w.first = rotate(y + z, 35) * k1 + x;
+        w.second = rotate(x + fetch64(s + 88), 53) * k1;
+
+        do {
+            for (int i = 0; i < 2; ++i) {
+                x = rotate(x + y + v.first + fetch64(s + 16), 37) * k1;
+                y = rotate(y + v.second + fetch64(s + 48), 42) * k1;
+                x ^= w.second;
+                y ^= v.first;
+                z = rotate(z ^ w.first, 33);
+                v = weakHashLen32WithSeeds(s, v.second * k1, x + w.first);
+                w = weakHashLen32WithSeeds(s + 32, z + w.second, y);
+                std::swap(z, x);
+                s += 64;
+            }
+            len -= 128;
+        } while (len >= 128);
+
+        y += rotate(w.first, 37) * k0 + z;
+        x += rotate(v.first + z, 49) * k0;
+
+        for (std::size_t tail_done = 0; tail_done < len; ) {
+            tail_done += 32;
+            y = rotate(y - x, 42) * k0 + v.second;
+            w.first += fetch64(s + len - tail_done + 16);
+            x = rotate(x, 49) * k0 + w.first;
+            w.first += v.first;
+            v = weakHashLen32WithSeeds(s + len - tail_done, v.first, v.second);
+        }
+
+        x = hashLen16(x, v.first);
+        y = hashLen16(y, w.first);
+        return uint128(hashLen16(x + v.second, w.second) + y, hashLen16(x + w.second, y + v.second));
+    }
+
+} // namespace city
+
+// ClickHouse native compressed block layout: [checksum: 16][method: 1][compressed size: 4][decompressed size: 4][payload].
+// Compressed size includes the 9 bytes of the header, and the checksum is calculated over the header and the payload.
+constexpr std::size_t block_checksum_size = 16;
+constexpr std::size_t block_header_size = 9;
+constexpr std::uint32_t max_block_size = 0x40000000; // 1 GiB, same limit as in ClickHouse.
+
+enum class BlockMethod : std::uint8_t {
+    None = 0x02,
+    LZ4 = 0x82,
+    ZSTD = 0x90
+};
+
+inline void writeUInt32LE(char * dest, std::uint32_t value) {
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+        dest[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+}
+
+inline std::uint32_t readUInt32LE(const char * src) {
+    std::uint32_t value = 0;
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+        value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(src[i])) << (i * 8);
+    return value;
+}
+
+inline void writeUInt64LE(char * dest, std::uint64_t value) {
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+        dest[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+}
+
+inline std::uint64_t readUInt64LE(const char * src) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+        value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(src[i])) << (i * 8);
+    return value;
+}
+
+} // namespace
+
+std::pair<std::uint64_t, std::uint64_t> cityHash128(const char * s, std::size_t len) {
+    if (len >= 16)
+        return city::cityHash128WithSeed(s + 16, len - 16, city::uint128(city::fetch64(s) ^ city::k3, city::fetch64(s + 8)));
+
+    if (len >= 8)
+        return city::cityHash128WithSeed(nullptr, 0, city::uint128(city::fetch64(s) ^ (len * city::k0), city::fetch64(s + len - 8) ^ city::k1));
+
+    return city::cityHash128WithSeed(s, len, city::uint128(city::k0, city::k1));
+}
+
+void writeCompressedBlock(std::string & dest, const char * data, std::size_t size) {
+    if (size > max_block_size || size > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE))
+        throw std::runtime_error("Block is too large to be compressed");
+
+    const auto offset = dest.size();
+    const auto max_payload_size = LZ4_compressBound(static_cast<int>(size));
+    dest.resize(offset + block_checksum_size + block_header_size + max_payload_size);
+
+    auto * block = &dest[offset + block_checksum_size];
+    const auto payload_size = LZ4_compress_default(data, block + block_header_size, static_cast<int>(size), max_payload_size);
+    if (payload_size <= 0)
+        throw std::runtime_error("LZ4 compression failed");
+
+    const auto compressed_size = static_cast<std::uint32_t>(block_header_size + payload_size);
+    block[0] = static_cast<char>(BlockMethod::LZ4);
+    writeUInt32LE(block + 1, compressed_size);
+    writeUInt32LE(block + 5, static_cast<std::uint32_t>(size));
+
+    const auto checksum = cityHash128(block, compressed_size);
+    writeUInt64LE(&dest[offset], checksum.first);
+    writeUInt64LE(&dest[offset + 8], checksum.second);
+
+    dest.resize(offset + block_checksum_size + compressed_size);
+}
+
+CompressedBlockStreamBuf::CompressedBlockStreamBuf(std::istream & in_, bool prefetch_)
+    : in(in_)
+    , prefetch(prefetch_)
+{
+}
+
+CompressedBlockStreamBuf::~CompressedBlockStreamBuf() {
+    if (next_block_ready.valid())
+        next_block_ready.wait();
+}
+
+bool CompressedBlockStreamBuf::isFinished() const {
+    return finished;
+}
+
+CompressedBlockStreamBuf::int_type CompressedBlockStreamBuf::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    while (!finished) {
+        bool has_block = false;
+
+        if (next_block_ready.valid()) {
+            has_block = next_block_ready.get();
+            current_block.swap(next_block);
+        }
+        else {
+            has_block = readBlock(current_block);
+        }
+
+        if (!has_block) {
+            finished = true;
+            break;
+        }
+
+        if (prefetch)
+            startPrefetch();
+
+        if (!current_block.empty()) {
+            setg(&current_block[0], &current_block[0], &current_block[0] + current_block.size());
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+
+    setg(nullptr, nullptr, nullptr);
+    return traits_type::eof();
+}
+
+void CompressedBlockStreamBuf::startPrefetch() {
+    next_block_ready = std::async(std::launch::async, [this] () { return readBlock(next_block); });
+}
+
+bool CompressedBlockStreamBuf::readBlock(std::string & dest) {
+    dest.clear();
+
+    char checksum_and_header[block_checksum_size + block_header_size];
+    in.read(checksum_and_header, sizeof(checksum_and_header));
+
+    if (in.gcount() == 0 && in.eof())
+        return false;
+
+    if (in.gcount() != sizeof(checksum_and_header))
+        throw std::runtime_error("Incomplete compressed block header");
+
+    const auto * header = checksum_and_header + block_checksum_size;
+    const auto method = static_cast<std::uint8_t>(header[0]);
+    const auto compressed_size = readUInt32LE(header + 1);
+    const auto decompressed_size = readUInt32LE(header + 5);
+
+    if (compressed_size < block_header_size || compressed_size > max_block_size || decompressed_size > max_block_size)
+        throw std::runtime_error("Too large or malformed compressed block");
+
+    // Keep the header in front of the payload, since the checksum covers both.
+    compressed.resize(compressed_size);
+    std::memcpy(&compressed[0], header, block_header_size);
+    in.read(&compressed[block_header_size], compressed_size - block_header_size);
+
+    if (static_cast<std::size_t>(in.gcount()) != compressed_size - block_header_size)
+        throw std::runtime_error("Incomplete compressed block");
+
+    const auto checksum = cityHash128(compressed.data(), compressed.size());
+    if (
+        checksum.first != readUInt64LE(checksum_and_header) ||
+        checksum.second != readUInt64LE(checksum_and_header + 8)
+    ) {
+        throw std::runtime_error("Checksum mismatch in compressed block");
+    }
+
+    const auto * payload = compressed.data() + block_header_size;
+    const auto payload_size = compressed_size - block_header_size;
+
+    switch (static_cast<BlockMethod>(method)) {
+        case BlockMethod::None: {
+            if (payload_size != decompressed_size)
+                throw std::runtime_error("Malformed uncompressed block");
+
+            dest.assign(payload, payload_size);
+            break;
+        }
+
+        case BlockMethod::LZ4: {
+            resize_without_initialization(dest, decompressed_size);
+            const auto res = LZ4_decompress_safe(payload, &dest[0], static_cast<int>(payload_size), static_cast<int>(decompressed_size));
+            if (res < 0 || static_cast<std::uint32_t>(res) != decompressed_size)
+                throw std::runtime_error("Cannot decompress LZ4 compressed block");
+            break;
+        }
+
+        default:
+            throw std::runtime_error("Unsupported compression method in compressed block: " + std::to_string(static_cast<int>(method)));
+    }
+
+    return true;
+}
+
+CompressedBlockInputStream::CompressedBlockInputStream(std::istream & in, bool prefetch)
+    : std::istream(nullptr)
+    , buf(in, prefetch)
+{
+    rdbuf(&buf);
+
+    // Rethrow the original exceptions from the stream buffer, instead of just setting the badbit.
+    exceptions(std::ios::badbit);
+}
+
+bool CompressedBlockInputStream::isFinished() const {
+    return buf.isFinished();
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+#include "driver/utils/amortized_istream_reader.h"
+
+#include <Poco/BufferedStreamBuf.h>
+#include <Poco/DeflatingStream.h>
+
+#include <cstdint>
+#include <future>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+struct LZ4F_cctx_s;
+
+enum class CompressionMethod {
+    None,
+    Gzip,
+    Deflate,
+    LZ4
+};
+
+// Parse a compression method name, as accepted in DSN/connection string ("off", "gzip", "deflate", "lz4"). Case insensitive.
+// Boolean values are accepted too: "on" means "gzip".
+bool tryParseCompressionMethod(const std::string & name, CompressionMethod & method);
+
+// Return the value of the HTTP Content-Encoding header that corresponds to the compression method, or empty string for None.
+std::string getContentEncoding(CompressionMethod method);
+
+// Bodies smaller than this are sent uncompressed, since the compression headers and CPU time outweigh the savings.
+inline constexpr std::size_t min_compressed_request_body_size = 1024;
+
+// Stream buffer that compresses everything written to it into a single LZ4 frame and writes it to the underlying stream.
+class LZ4FrameStreamBuf
+    : public Poco::BufferedStreamBuf
+{
+public:
+    explicit LZ4FrameStreamBuf(std::ostream & out);
+    ~LZ4FrameStreamBuf();
+
+    // Flush the pending data and write the frame end mark. Must be called after all the data has been written.
+    void close();
+
+protected:
+    virtual int writeToDevice(const char * buffer, std::streamsize length) override;
+
+private:
+    void writeOut(std::size_t size);
+
+private:
+    enum {
+        STREAM_BUFFER_SIZE = 64 * 1024
+    };
+
+    std::ostream * out = nullptr;
+    LZ4F_cctx_s * context = nullptr;
+    std::string frame_buffer;
+    bool closed = false;
+};
+
+// Output stream that compresses everything written to it using the specified method, and writes the result to the underlying stream.
+// close() must be called after all the data has been written, to flush the compressor state and write the trailing marks.
+class CompressingOutputStream
+    : public std::ostream
+{
+public:
+    explicit CompressingOutputStream(std::ostream & out, CompressionMethod method);
+    ~CompressingOutputStream();
+
+    void close();
+
+private:
+    std::unique_ptr<Poco::DeflatingStreamBuf> deflating_buf;
+    std::unique_ptr<LZ4FrameStreamBuf> lz4_buf;
+};
+
+// CityHash v1.0.2 128-bit hash (low and high 64-bit halves), as used by ClickHouse for checksums of compressed blocks.
+// Note, that later versions of CityHash produce different values.
+std::pair<std::uint64_t, std::uint64_t> cityHash128(const char * data, std::size_t size);
+
+// Append data to dest as a single ClickHouse native compressed block (checksum, header, LZ4 compressed payload).
+void writeCompressedBlock(std::string & dest, const char * data, std::size_t size);
+
+// Stream buffer that reads ClickHouse native compressed blocks (as sent by the server when "compress=1" is specified)
+// from the underlying stream, verifies their checksums, and hands out whole decompressed blocks.
+// If prefetch is enabled, the next block is read and decompressed on a worker thread while the current one is being consumed.
+// The blocks are parsed in place by AmortizedIStreamReader.
+class CompressedBlockStreamBuf
+    : public ContiguousStreamBuf
+{
+public:
+    explicit CompressedBlockStreamBuf(std::istream & in, bool prefetch = true);
+
+    // Waits for the prefetch worker, if any, so the underlying stream must be aborted first if it may block (see isFinished()).
+    ~CompressedBlockStreamBuf();
+
+    // Whether the underlying stream has been read to the end, i.e., no worker is reading it anymore.
+    bool isFinished() const;
+
+protected:
+    virtual int_type underflow() override;
+
+private:
+    // Read and decompress the next block into dest. Return false if the underlying stream ended cleanly at a block boundary.
+    bool readBlock(std::string & dest);
+
+    void startPrefetch();
+
+private:
+    std::istream & in;
+    const bool prefetch;
+    bool finished = false;
+    std::string compressed; // Used only by the reader of the next block, i.e., by one thread at a time.
+    std::string current_block;
+    std::string next_block;
+    std::future<bool> next_block_ready; // Must be destroyed before the buffers.
+};
+
+// Input stream over CompressedBlockStreamBuf. Errors (e.g., checksum mismatch) are rethrown from the read operations.
+class CompressedBlockInputStream
+    : public std::istream
+{
+public:
+    explicit CompressedBlockInputStream(std::istream & in, bool prefetch = true);
+
+    bool isFinished() const;
+
+private:
+    CompressedBlockStreamBuf buf;
+};
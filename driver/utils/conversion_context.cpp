@@ -15,7 +15,7 @@ UnicodeConversionContext::UnicodeConversionContext(
     , data_source_narrow_char_converter  {data_source_narrow_char_encoding}
     , driver_pivot_narrow_char_converter {driver_pivot_narrow_char_encoding}
 
-    , skip_application_to_converter_pivot_wide_char_conversion (sameEncoding(application_wide_char_encoding, converter_pivot_wide_char_encoding))
+    , skip_application_to_converter_pivot_wide_char_conversion (application_wide_char_converter.isPivotEncoding())
     , skip_application_to_driver_pivot_narrow_char_conversion  (sameEncoding(application_narrow_char_encoding, driver_pivot_narrow_char_encoding))
     , skip_data_source_to_driver_pivot_narrow_char_conversion  (sameEncoding(data_source_narrow_char_encoding, driver_pivot_narrow_char_encoding))
 {
@@ -25,6 +25,9 @@ public:
 public:
     StringPool string_pool{10};
 
+    // Scratch buffer for the intermediate pivot representation, reused by all conversions done via this context.
+    std::basic_string<ConverterPivotWideCharType> pivot_buffer;
+
     UnicodeConverter application_wide_char_converter;
     UnicodeConverter application_narrow_char_converter;
     UnicodeConverter data_source_narrow_char_converter;
@@ -35,5 +38,12 @@ public:
     const bool skip_data_source_to_driver_pivot_narrow_char_conversion  = false;
 };
 
+// Lazily created per-thread context, for the call sites that don't have a context of their own at hand.
+// Creating a context opens several ICU converters, which is far too expensive to do on each conversion.
+inline UnicodeConversionContext & getThreadLocalConversionContext() {
+    thread_local UnicodeConversionContext context;
+    return context;
+}
+
 // In future, this will become an aggregate context that will do proper date/time, etc., conversions also.
 using DefaultConversionContext = UnicodeConversionContext;
@@ -84,9 +84,7 @@ namespace value_manip {
                         std::memcpy(&dest[0], &src_no_sig[0], src_no_sig.size() * sizeof(SourceCharType));
                     }
                     else {
-                        auto pivot = context.string_pool.template allocateString<ConverterPivotWideCharType>();
-                        convertEncoding(context.application_narrow_char_converter, src, pivot, context.driver_pivot_narrow_char_converter, dest);
-                        context.string_pool.retireString(std::move(pivot));
+                        convertEncoding(context.application_narrow_char_converter, src, context.pivot_buffer, context.driver_pivot_narrow_char_converter, dest);
                     }
                 }
                 else if constexpr (sizeof(SourceCharType) == sizeof(ApplicationWideCharType)) {
@@ -98,9 +96,7 @@ namespace value_manip {
                             context.driver_pivot_narrow_char_converter.convertFromPivot(src, dest, true, true);
                     }
                     else {
-                        auto pivot = context.string_pool.template allocateString<ConverterPivotWideCharType>();
-                        convertEncoding(context.application_wide_char_converter, src, pivot, context.driver_pivot_narrow_char_converter, dest);
-                        context.string_pool.retireString(std::move(pivot));
+                        convertEncoding(context.application_wide_char_converter, src, context.pivot_buffer, context.driver_pivot_narrow_char_converter, dest);
                     }
                 }
                 else {
@@ -172,9 +168,7 @@ namespace value_manip {
                     std::memcpy(&dest[0], &src_no_sig[0], src_no_sig.size() * sizeof(DriverPivotNarrowCharType));
                 }
                 else {
-                    auto pivot = context.string_pool.template allocateString<ConverterPivotWideCharType>();
-                    convertEncoding(context.driver_pivot_narrow_char_converter, src, pivot, context.application_narrow_char_converter, dest);
-                    context.string_pool.retireString(std::move(pivot));
+                    convertEncoding(context.driver_pivot_narrow_char_converter, src, context.pivot_buffer, context.application_narrow_char_converter, dest);
                 }
             }
             else if constexpr (sizeof(DestinationCharType) == sizeof(ApplicationWideCharType)) {
@@ -186,9 +180,7 @@ namespace value_manip {
                         context.driver_pivot_narrow_char_converter.convertToPivot(src, dest, true, true);
                 }
                 else {
-                    auto pivot = context.string_pool.template allocateString<ConverterPivotWideCharType>();
-                    convertEncoding(context.driver_pivot_narrow_char_converter, src, pivot, context.application_wide_char_converter, dest);
-                    context.string_pool.retireString(std::move(pivot));
+                    convertEncoding(context.driver_pivot_narrow_char_converter, src, context.pivot_buffer, context.application_wide_char_converter, dest);
                 }
             }
             else {
@@ -224,10 +216,9 @@ namespace value_manip {
 
 template <typename CharType>
 inline std::size_t stringLength(const std::basic_string_view<CharType> & str, UnicodeConverter & converter, UnicodeConversionContext & context) {
-    auto pivot = context.string_pool.allocateString<ConverterPivotWideCharType>();
+    auto & pivot = context.pivot_buffer;
     converter.convertToPivot(str, pivot, true, true);
     const auto len = u_countChar32(pivot.c_str(), pivot.size());
-    context.string_pool.retireString(std::move(pivot));
     return (len > 0 ? len : 0);
 }
 
@@ -305,7 +296,7 @@ inline auto toUTF8(const std::basic_string_view<CharType> & src, UnicodeConversi
 
 template <typename CharType>
 inline auto toUTF8(const std::basic_string_view<CharType> & src) {
-    UnicodeConversionContext context;
+    auto & context = getThreadLocalConversionContext();
     return toUTF8(src, context);
 }
 
@@ -339,7 +330,7 @@ inline auto toUTF8(const CharType * src, UnicodeConversionContext & context) {
 
 template <typename CharType>
 inline auto toUTF8(const CharType * src, SQLLEN length = SQL_NTS) {
-    UnicodeConversionContext context;
+    auto & context = getThreadLocalConversionContext();
     return toUTF8(src, length, context);
 }
 
@@ -355,7 +346,7 @@ inline auto fromUTF8(const std::basic_string_view<DriverPivotNarrowCharType> & s
 
 template <typename CharType>
 inline auto fromUTF8(const std::basic_string_view<DriverPivotNarrowCharType> & src) {
-    UnicodeConversionContext context;
+    auto & context = getThreadLocalConversionContext();
     return fromUTF8<CharType>(src, context);
 }
 
@@ -383,7 +374,7 @@ inline auto fromUTF8(const DriverPivotNarrowCharType * src, UnicodeConversionCon
 
 template <typename CharType>
 inline auto fromUTF8(const DriverPivotNarrowCharType * src, SQLLEN length = SQL_NTS) {
-    UnicodeConversionContext context;
+    auto & context = getThreadLocalConversionContext();
     return fromUTF8<CharType>(src, length, context);
 }
 
@@ -394,7 +385,7 @@ inline void fromUTF8(const std::basic_string_view<DriverPivotNarrowCharType> & s
 
 template <typename CharType>
 inline void fromUTF8(const std::basic_string_view<DriverPivotNarrowCharType> & src, std::basic_string<CharType> & dest) {
-    UnicodeConversionContext context;
+    auto & context = getThreadLocalConversionContext();
     return fromUTF8<CharType>(src, dest, context);
 }
 
@@ -420,7 +411,7 @@ inline void fromUTF8(const DriverPivotNarrowCharType * src, std::basic_string<Ch
 
 template <typename CharType>
 inline void fromUTF8(const DriverPivotNarrowCharType * src, SQLLEN src_length, std::basic_string<CharType> & dest) {
-    UnicodeConversionContext context;
+    auto & context = getThreadLocalConversionContext();
     return fromUTF8<CharType>(src, src_length, dest, context);
 }
 
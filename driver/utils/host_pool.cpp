@@ -0,0 +1,168 @@
+#include "driver/utils/host_pool.h"
+
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+void HostPool::reset(std::vector<Endpoint> endpoints_) {
+    std::lock_guard<std::mutex> lock(mutex);
+    endpoints = std::move(endpoints_);
+    health.assign(endpoints.size(), Health{});
+}
+
+std::size_t HostPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return endpoints.size();
+}
+
+HostPool::Endpoint HostPool::getEndpoint(std::size_t idx) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return endpoints.at(idx);
+}
+
+std::size_t HostPool::pick(std::size_t exclude, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (endpoints.empty())
+        throw std::runtime_error("No server endpoints configured");
+
+    if (endpoints.size() == 1)
+        return 0;
+
+    std::vector<std::size_t> candidates;
+    candidates.reserve(endpoints.size());
+
+    for (std::size_t i = 0; i < endpoints.size(); ++i) {
+        if (i != exclude && health[i].backoff_until <= now)
+            candidates.push_back(i);
+    }
+
+    if (candidates.empty()) {
+        std::size_t best = npos;
+        for (std::size_t i = 0; i < endpoints.size(); ++i) {
+            if (i != exclude && (best == npos || health[i].backoff_until < health[best].backoff_until))
+                best = i;
+        }
+        return best;
+    }
+
+    if (candidates.size() == 1)
+        return candidates.front();
+
+    std::uniform_int_distribution<std::size_t> distribution(0, candidates.size() - 1);
+    const auto first = distribution(random);
+    auto second = distribution(random);
+    if (second == first)
+        second = (first + 1) % candidates.size();
+
+    return (isBetter(candidates[second], candidates[first]) ? candidates[second] : candidates[first]);
+}
+
+bool HostPool::isBetter(std::size_t lhs, std::size_t rhs) const {
+    const auto & lhs_health = health[lhs];
+    const auto & rhs_health = health[rhs];
+
+    if (lhs_health.consecutive_failures != rhs_health.consecutive_failures)
+        return (lhs_health.consecutive_failures < rhs_health.consecutive_failures);
+
+    return (lhs_health.latency_ewma_us < rhs_health.latency_ewma_us);
+}
+
+void HostPool::reportSuccess(std::size_t idx, Clock::duration latency) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (idx >= health.size())
+        return;
+
+    auto & entry = health[idx];
+    const auto sample = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+
+    if (entry.latency_ewma_us == 0.0)
+        entry.latency_ewma_us = std::max(sample, 1.0);
+    else
+        entry.latency_ewma_us = latency_ewma_alpha * sample + (1.0 - latency_ewma_alpha) * entry.latency_ewma_us;
+
+    entry.consecutive_failures = 0;
+    entry.backoff_until = Clock::time_point{};
+}
+
+void HostPool::reportFailure(std::size_t idx, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (idx >= health.size())
+        return;
+
+    auto & entry = health[idx];
+    ++entry.consecutive_failures;
+
+    if (entry.consecutive_failures >= failures_before_backoff) {
+        const auto exponent = std::min<unsigned int>(entry.consecutive_failures - failures_before_backoff, 16);
+        entry.backoff_until = now + std::min<Clock::duration>(min_backoff * (1u << exponent), max_backoff);
+    }
+}
+
+bool tryParseHostList(const std::string & str, std::uint16_t default_port, std::vector<HostPool::Endpoint> & endpoints) {
+    std::vector<HostPool::Endpoint> result;
+
+    std::size_t begin = 0;
+    while (begin <= str.size()) {
+        auto end = str.find(',', begin);
+        if (end == std::string::npos)
+            end = str.size();
+
+        const auto item = Poco::trim(str.substr(begin, end - begin));
+        begin = end + 1;
+
+        if (item.empty())
+            return false;
+
+        HostPool::Endpoint endpoint;
+        endpoint.port = default_port;
+
+        std::size_t port_pos = std::string::npos;
+        if (item.front() == '[') { // [IPv6]:port
+            const auto closing = item.find(']');
+            if (closing == std::string::npos)
+                return false;
+
+            endpoint.host = item.substr(1, closing - 1);
+            if (closing + 1 < item.size()) {
+                if (item[closing + 1] != ':')
+                    return false;
+                port_pos = closing + 2;
+            }
+        }
+        else {
+            const auto colon = item.find(':');
+            if (colon != std::string::npos && item.find(':', colon + 1) == std::string::npos) {
+                endpoint.host = item.substr(0, colon);
+                port_pos = colon + 1;
+            }
+            else {
+                endpoint.host = item; // Host name, or IPv6 address without port.
+            }
+        }
+
+        if (port_pos != std::string::npos) {
+            unsigned int port = 0;
+            if (
+                !Poco::NumberParser::tryParseUnsigned(item.substr(port_pos), port) ||
+                port == 0 ||
+                port > std::numeric_limits<std::uint16_t>::max()
+            ) {
+                return false;
+            }
+            endpoint.port = static_cast<std::uint16_t>(port);
+        }
+
+        if (endpoint.host.empty())
+            return false;
+
+        result.push_back(std::move(endpoint));
+    }
+
+    endpoints = std::move(result);
+    return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+// A list of server endpoints (replicas) with their health statistics, used to route requests to the best healthy replica.
+// Keeps an EWMA of the response latency and a count of consecutive failures per endpoint. An endpoint that fails repeatedly
+// is excluded for an exponentially growing backoff period. Thread-safe.
+class HostPool
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Endpoint {
+        std::string host;
+        std::uint16_t port = 0;
+    };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    // Number of consecutive failures after which an endpoint is put into backoff.
+    static constexpr unsigned int failures_before_backoff = 2;
+
+    static constexpr Clock::duration min_backoff = std::chrono::milliseconds(500);
+    static constexpr Clock::duration max_backoff = std::chrono::seconds(30);
+
+    // Weight of the latest sample in the latency EWMA.
+    static constexpr double latency_ewma_alpha = 0.2;
+
+public:
+    HostPool() = default;
+
+    HostPool(const HostPool &) = delete;
+    HostPool & operator= (const HostPool &) = delete;
+
+    // Replace the endpoints and reset their statistics.
+    void reset(std::vector<Endpoint> endpoints);
+
+    std::size_t size() const;
+    Endpoint getEndpoint(std::size_t idx) const;
+
+    // Choose an endpoint for the next request, avoiding the excluded one (e.g., the one that has just failed) if there are alternatives.
+    // Among the endpoints that are not in backoff, picks the better of two random candidates (fewer consecutive failures, then lower latency),
+    // which spreads the load while preferring faster replicas. If all the endpoints are in backoff, picks the one that leaves it first.
+    std::size_t pick(std::size_t exclude = npos, Clock::time_point now = Clock::now());
+
+    void reportSuccess(std::size_t idx, Clock::duration latency);
+    void reportFailure(std::size_t idx, Clock::time_point now = Clock::now());
+
+private:
+    struct Health {
+        double latency_ewma_us = 0.0; // 0 means "not measured yet", such endpoints are preferred, so they get probed early.
+        unsigned int consecutive_failures = 0;
+        Clock::time_point backoff_until;
+    };
+
+    bool isBetter(std::size_t lhs, std::size_t rhs) const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<Endpoint> endpoints;
+    std::vector<Health> health;
+    std::minstd_rand random{std::random_device{}()};
+};
+
+// Parse a comma-separated list of "host[:port]" items (IPv6 addresses must be in brackets if a port is specified).
+// Items without a port get the default port.
+bool tryParseHostList(const std::string & str, std::uint16_t default_port, std::vector<HostPool::Endpoint> & endpoints);
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+// A map of at most max_size entries, that evicts the least recently used one when full.
+// Values are returned by copy, so they should be cheap to copy, e.g., std::shared_ptr's to immutable objects. Thread-safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+public:
+    explicit LRUCache(const std::size_t max_size)
+        : max_size_(max_size)
+    {
+    }
+
+    LRUCache(const LRUCache &) = delete;
+    LRUCache & operator= (const LRUCache &) = delete;
+
+    bool tryGet(const Key & key, Value & value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto it = index_.find(key);
+        if (it == index_.end())
+            return false;
+
+        entries_.splice(entries_.begin(), entries_, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    void put(const Key & key, Value value) {
+        if (max_size_ == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto it = index_.find(key);
+        if (it != index_.end()) {
+            it->second->second = std::move(value);
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+
+        entries_.emplace_front(key, std::move(value));
+        try {
+            index_.emplace(key, entries_.begin());
+        }
+        catch (...) {
+            entries_.pop_front();
+            throw;
+        }
+
+        while (entries_.size() > max_size_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+    std::size_t getSize() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index_.clear();
+        entries_.clear();
+    }
+
+private:
+    using Entries = std::list<std::pair<Key, Value>>;
+
+    const std::size_t max_size_;
+    mutable std::mutex mutex_;
+    Entries entries_; // Most recently used first.
+    std::unordered_map<Key, typename Entries::iterator, Hash> index_;
+};
@@ -0,0 +1,155 @@
+#include "driver/utils/retry_policy.h"
+
+#include <Poco/DateTime.h>
+#include <Poco/DateTimeFormat.h>
+#include <Poco/DateTimeParser.h>
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
+#include <Poco/Timestamp.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+
+RetryPolicy::Clock::duration RetryPolicy::getBackoff(int attempt) const {
+    thread_local std::minstd_rand random{std::random_device{}()};
+
+    const auto exponent = std::clamp(attempt - 1, 0, 20);
+    const auto limit = std::min<Clock::duration>(base_backoff * (1ull << exponent), max_backoff);
+
+    if (limit <= Clock::duration::zero())
+        return Clock::duration::zero();
+
+    std::uniform_int_distribution<Clock::rep> distribution(0, limit.count());
+    return Clock::duration(distribution(random));
+}
+
+FailureAction RetryPolicy::getFailureAction(int attempt, const RequestFailure & failure, bool idempotent, bool has_query_timeout) const {
+    if (failure.timeout && failure.request_sent && has_query_timeout)
+        return FailureAction::QueryTimeout;
+
+    if (attempt > max_retries || !(idempotent || failure.no_response))
+        return FailureAction::Fail;
+
+    return FailureAction::Retry;
+}
+
+ResponseAction RetryPolicy::getResponseAction(int attempt, int http_status) const {
+    constexpr int too_many_requests = 429;
+    constexpr int service_unavailable = 503;
+
+    ResponseAction action;
+
+    if (http_status == too_many_requests || http_status == service_unavailable) {
+        action.endpoint_failed = true;
+        action.trip_breaker = (http_status == service_unavailable);
+        action.retry = (attempt <= max_retries);
+    }
+
+    return action;
+}
+
+bool isIdempotentQuery(const std::string & query) {
+    static const std::array<std::string, 7> read_only_keywords = {
+        "SELECT", "WITH", "SHOW", "DESCRIBE", "DESC", "EXISTS", "EXPLAIN"
+    };
+
+    // Skip leading spaces, comments and opening parentheses.
+    std::size_t pos = 0;
+    while (pos < query.size()) {
+        if (std::isspace(static_cast<unsigned char>(query[pos])) || query[pos] == '(') {
+            ++pos;
+        }
+        else if (query.compare(pos, 2, "--") == 0) {
+            pos = query.find('\n', pos);
+        }
+        else if (query.compare(pos, 2, "/*") == 0) {
+            pos = query.find("*/", pos + 2);
+            if (pos != std::string::npos)
+                pos += 2;
+        }
+        else {
+            break;
+        }
+    }
+
+    if (pos >= query.size())
+        return false;
+
+    auto end = pos;
+    while (end < query.size() && std::isalpha(static_cast<unsigned char>(query[end])))
+        ++end;
+
+    const auto keyword = query.substr(pos, end - pos);
+    return std::any_of(read_only_keywords.begin(), read_only_keywords.end(), [&] (const auto & read_only_keyword) {
+        return (Poco::icompare(keyword, read_only_keyword) == 0);
+    });
+}
+
+bool tryParseRetryAfter(const std::string & value, RetryPolicy::Clock::duration & delay) {
+    const auto trimmed = Poco::trim(value);
+    if (trimmed.empty())
+        return false;
+
+    unsigned int seconds = 0;
+    if (Poco::NumberParser::tryParseUnsigned(trimmed, seconds)) {
+        delay = std::chrono::seconds(seconds);
+        return true;
+    }
+
+    // HTTP-date is always in GMT, e.g., "Sun, 06 Nov 1994 08:49:37 GMT". Poco's parser is too lenient to rely on it alone.
+    if (trimmed.size() < 4 || trimmed.compare(trimmed.size() - 4, 4, " GMT") != 0)
+        return false;
+
+    Poco::DateTime date_time;
+    int tzd = 0;
+    if (!Poco::DateTimeParser::tryParse(Poco::DateTimeFormat::HTTP_FORMAT, trimmed, date_time, tzd))
+        return false;
+
+    const auto diff_us = date_time.timestamp() - Poco::Timestamp() - static_cast<Poco::Timestamp::TimeDiff>(tzd) * Poco::Timestamp::resolution();
+    delay = std::chrono::duration_cast<RetryPolicy::Clock::duration>(std::chrono::microseconds(std::max<Poco::Timestamp::TimeDiff>(diff_us, 0)));
+    return true;
+}
+
+CircuitBreaker & CircuitBreaker::forEndpoint(const std::string & host, std::uint16_t port) {
+    static std::mutex registry_mutex;
+    static std::map<std::pair<std::string, std::uint16_t>, std::unique_ptr<CircuitBreaker>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto & breaker = registry[{host, port}];
+    if (!breaker)
+        breaker = std::make_unique<CircuitBreaker>();
+    return *breaker;
+}
+
+bool CircuitBreaker::allowRequest(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (consecutive_failures < failure_threshold)
+        return true;
+
+    if (now < open_until)
+        return false;
+
+    // Half-open: let this request through as a trial, and keep rejecting the others until its outcome is known, or for another period.
+    open_until = now + open_duration;
+    return true;
+}
+
+void CircuitBreaker::reportSuccess() {
+    std::lock_guard<std::mutex> lock(mutex);
+    consecutive_failures = 0;
+    open_until = Clock::time_point{};
+}
+
+void CircuitBreaker::reportFailure(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    ++consecutive_failures;
+    if (consecutive_failures >= failure_threshold)
+        open_until = now + open_duration;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// What is known about a failed attempt to send a request and receive its response.
+struct RequestFailure {
+    bool timeout = false;      // Timed out, as opposed to other I/O errors.
+    bool request_sent = false; // The request has been sent completely, i.e., the failure happened while waiting for or receiving the response.
+    bool no_response = false;  // No part of the response has arrived.
+};
+
+enum class FailureAction {
+    Retry,       // The endpoint has failed, and the request may be sent again, preferably to another replica.
+    Fail,        // The endpoint has failed, and the request must not be sent again.
+    QueryTimeout // The query has run out of its time limit. The endpoint is not to blame, and the request is not sent again.
+};
+
+// How a response, received from an endpoint before its body is read, is accounted for.
+struct ResponseAction {
+    bool endpoint_failed = false; // Report a failure of the endpoint to the host pool, instead of a success.
+    bool trip_breaker = false;    // Count the failure towards opening the circuit breaker of the endpoint, too.
+    bool retry = false;           // Send the request again, after a backoff.
+};
+
+// Decides whether and how long to wait before retrying a failed HTTP request.
+struct RetryPolicy {
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Clock::duration max_backoff = std::chrono::seconds(10);
+
+    // Upper limit for the delay requested by the server in Retry-After header.
+    static constexpr Clock::duration max_retry_after = std::chrono::seconds(60);
+
+    int max_retries = 3;
+    Clock::duration base_backoff = std::chrono::milliseconds(100);
+
+    // Exponential backoff with "full jitter": a random delay in [0, min(max_backoff, base_backoff * 2^(attempt - 1))],
+    // so that clients that failed at the same moment don't retry in lockstep. Attempts are counted from 1.
+    Clock::duration getBackoff(int attempt) const;
+
+    // Timeouts of connecting and sending the request, as well as timeouts of receiving the response when the query has no time limit
+    // of its own, mean that the endpoint is unresponsive, and are handled like other I/O errors. Non-idempotent queries are retried
+    // only if no part of the response has arrived. Attempts are counted from 1.
+    FailureAction getFailureAction(int attempt, const RequestFailure & failure, bool idempotent, bool has_query_timeout) const;
+
+    // Responses with 503 Service Unavailable or 429 Too Many Requests mean that the query has been rejected without being executed
+    // by an overloaded endpoint, so they are retried, and reported as failures, even when there are no attempts left. A throttling
+    // endpoint (429) is alive, so it doesn't trip the circuit breaker. Any other status is a success of the endpoint. Attempts are counted from 1.
+    ResponseAction getResponseAction(int attempt, int http_status) const;
+};
+
+// Check whether the query may be safely sent again after a failure, whose outcome on the server side is unknown,
+// i.e., whether the query is read-only (SELECT, WITH, SHOW, DESCRIBE, EXISTS, EXPLAIN).
+bool isIdempotentQuery(const std::string & query);
+
+// Parse the value of Retry-After HTTP header: either a number of seconds or an HTTP-date.
+bool tryParseRetryAfter(const std::string & value, RetryPolicy::Clock::duration & delay);
+
+// Process-wide per-endpoint circuit breaker. After failure_threshold consecutive failures of requests to an endpoint,
+// the breaker opens and requests to that endpoint are rejected without being sent for open_duration. After that,
+// a single trial request is let through per open_duration, and a success closes the breaker. Thread-safe.
+class CircuitBreaker
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr unsigned int failure_threshold = 5;
+    static constexpr Clock::duration open_duration = std::chrono::seconds(5);
+
+public:
+    CircuitBreaker() = default;
+
+    CircuitBreaker(const CircuitBreaker &) = delete;
+    CircuitBreaker & operator= (const CircuitBreaker &) = delete;
+
+    // Get the breaker shared by all the connections of this process to the endpoint.
+    static CircuitBreaker & forEndpoint(const std::string & host, std::uint16_t port);
+
+    bool allowRequest(Clock::time_point now = Clock::now());
+    void reportSuccess();
+    void reportFailure(Clock::time_point now = Clock::now());
+
+private:
+    std::mutex mutex;
+    unsigned int consecutive_failures = 0;
+    Clock::time_point open_until;
+};
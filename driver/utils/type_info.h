@@ -4,13 +4,25 @@
 #include "driver/utils/utils.h"
 #include "driver/utils/sql_encoding.h"
 #include "driver/utils/conversion.h"
+#include "driver/utils/uint128.h"
 #include "driver/exception.h"
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
 
 #define lengthof(a) (sizeof(a) / sizeof(a[0]))
 
@@ -259,6 +271,21 @@ struct BindingInfo {
     std::int16_t scale = 0;
 };
 
+/// Get the binding of the row_idx-th row of a bound array, given the binding of its first row,
+/// the bind type (SQL_BIND_BY_COLUMN, or the size of a row structure), and the bind offset.
+inline BindingInfo getRowBinding(const BindingInfo & base_binding, std::size_t row_idx, SQLULEN bind_type, SQLULEN bind_offset) {
+    const auto next_value_ptr_increment = (bind_type == SQL_BIND_BY_COLUMN ? base_binding.value_max_size : bind_type);
+    const auto next_sz_ind_ptr_increment = (bind_type == SQL_BIND_BY_COLUMN ? sizeof(SQLLEN) : bind_type);
+
+    BindingInfo binding_info;
+    binding_info.c_type = base_binding.c_type;
+    binding_info.value_max_size = base_binding.value_max_size;
+    binding_info.value = (SQLPOINTER)(base_binding.value ? ((char *)(base_binding.value) + row_idx * next_value_ptr_increment + bind_offset) : 0);
+    binding_info.value_size = (SQLLEN *)(base_binding.value_size ? ((char *)(base_binding.value_size) + row_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
+    binding_info.indicator = (SQLLEN *)(base_binding.indicator ? ((char *)(base_binding.indicator) + row_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
+    return binding_info;
+}
+
 /// Helper structure that represents information about where and
 /// how to get or put values when reading or writing bound parameter buffers.
 struct ParamBindingInfo
@@ -272,7 +299,15 @@ struct ParamBindingInfo
 /// Helper structure that represents different aspects of parameter info in a prepared query.
 struct ParamInfo {
     std::string name;
-    std::string tmp_placeholder;
+    std::size_t marker_pos = 0;  // Position of the parameter marker ("?" or "@name") in the query text.
+    std::size_t marker_size = 0;
+};
+
+/// Query text prepared for execution, i.e., with escape sequences replaced, along with the parameters,
+/// whose markers are substituted when the final query is built. Doesn't depend on the statement, so it is shared between the statements of a connection.
+struct PreparedQueryTemplate {
+    std::string query;
+    std::vector<ParamInfo> parameters;
 };
 
 struct BoundTypeInfo {
@@ -614,14 +649,20 @@ struct DataSourceType<DataSourceTypeId::DateTime64>
     using SimpleTypeWrapper<SQL_TIMESTAMP_STRUCT>::SimpleTypeWrapper;
 };
 
+// An unsigned integer type big enough to hold the integer value that is built from all
+// decimal digits of Decimal/Numeric values, as if there is no decimal point.
+// Size of this integer defines the upper bound of the "info" the internal
+// representation can carry. 128 bits match the mantissa of SQL_NUMERIC_STRUCT
+// and the widest ClickHouse Decimal we decode, so no conversion needs a string proxy.
+#if defined(__SIZEOF_INT128__)
+using DecimalMantissaType = unsigned __int128;
+#else
+using DecimalMantissaType = UInt128;
+#endif
+
 template <>
 struct DataSourceType<DataSourceTypeId::Decimal> {
-    // An integer type big enough to hold the integer value that is built from all
-    // decimal digits of Decimal/Numeric values, as if there is no decimal point.
-    // Size of this integer defines the upper bound of the "info" the internal
-    // representation can carry.
-    // TODO: switch to some 128-bit or even arbitrary-precision unsigned integer type.
-    using ContainerIntType = std::uint_fast64_t;
+    using ContainerIntType = DecimalMantissaType;
 
     ContainerIntType value = 0;
     std::int8_t sign = 0;
@@ -808,6 +849,291 @@ namespace value_manip {
 
     // TODO: implement getDecimalDigits() for other types.
 
+    // Helpers for integer-only manipulations of Decimal/Numeric mantissas.
+    namespace decimal {
+
+        inline constexpr DecimalMantissaType mantissa_max = ~DecimalMantissaType{0};
+
+        // The biggest N for which 10^N still fits into the mantissa type.
+        inline constexpr std::size_t max_pow10 = 38;
+
+        inline constexpr auto pow10_table = [] {
+            std::array<DecimalMantissaType, max_pow10 + 1> table{};
+            DecimalMantissaType value = 1;
+            for (auto & entry : table) {
+                entry = value;
+                value *= 10;
+            }
+            return table;
+        }();
+
+        // Count of decimal digits in the value, 0 is considered to have 1 digit.
+        inline std::int16_t digitCount(DecimalMantissaType value) {
+            std::int16_t count = 1;
+            while (count <= static_cast<std::int16_t>(max_pow10) && pow10_table[count] <= value)
+                ++count;
+            return count;
+        }
+
+        // Multiply the mantissa by 10^(to_scale - from_scale), or divide it (truncating) by 10^(from_scale - to_scale).
+        // Return false if the result does not fit into the mantissa type.
+        inline bool tryRescale(DecimalMantissaType & value, std::int32_t from_scale, std::int32_t to_scale) {
+            while (from_scale < to_scale) {
+                const auto step = std::min<std::int32_t>(to_scale - from_scale, max_pow10);
+                const auto mult = pow10_table[step];
+
+                if (value != 0 && (mantissa_max / mult) < value)
+                    return false;
+
+                value *= mult;
+                from_scale += step;
+            }
+
+            while (to_scale < from_scale) {
+                const auto step = std::min<std::int32_t>(from_scale - to_scale, max_pow10);
+                value /= pow10_table[step];
+                from_scale -= step;
+            }
+
+            return true;
+        }
+
+        // Read the little-endian unsigned integer stored in SQL_NUMERIC_STRUCT::val.
+        inline bool tryLoadMantissa(const SQL_NUMERIC_STRUCT & numeric, DecimalMantissaType & value) {
+            constexpr auto value_bits = sizeof(DecimalMantissaType) * 8;
+
+            value = 0;
+            for (std::size_t i = lengthof(numeric.val); i > 0; --i) {
+                if ((value >> (value_bits - 8)) != 0)
+                    return false;
+
+                value = (value << 8) | static_cast<unsigned char>(numeric.val[i - 1]);
+            }
+
+            return true;
+        }
+
+        // Write the value into SQL_NUMERIC_STRUCT::val as a little-endian unsigned integer.
+        inline bool tryStoreMantissa(DecimalMantissaType value, SQL_NUMERIC_STRUCT & numeric) {
+            for (std::size_t i = 0; i < lengthof(numeric.val); ++i) {
+                numeric.val[i] = static_cast<SQLCHAR>(value & 0xFF);
+                value >>= 8;
+            }
+
+            return (value == 0);
+        }
+
+        // Write decimal digits of the value right-to-left, ending at 'end'. Return the pointer to the first digit.
+        // The buffer must be able to hold at least 40 characters.
+        inline char * writeDigitsBackwards(DecimalMantissaType value, char * end) {
+            constexpr std::uint64_t chunk_mult = 10000000000000000000ull; // 10^19
+            constexpr std::size_t chunk_digits = 19;
+
+            auto * pos = end;
+
+            // Peel off 19-digit chunks first, so that the most of the work is done in native 64-bit arithmetic.
+            while (value > std::numeric_limits<std::uint64_t>::max()) {
+                auto chunk = static_cast<std::uint64_t>(value % chunk_mult);
+                value /= chunk_mult;
+
+                for (std::size_t i = 0; i < chunk_digits; ++i) {
+                    *--pos = static_cast<char>('0' + chunk % 10);
+                    chunk /= 10;
+                }
+            }
+
+            auto rest = static_cast<std::uint64_t>(value);
+            do {
+                *--pos = static_cast<char>('0' + rest % 10);
+                rest /= 10;
+            } while (rest != 0);
+
+            return pos;
+        }
+
+    } // namespace decimal
+
+    namespace datetime {
+
+        // Howard Hinnant's days_from_civil(): proleptic Gregorian date to the number of days since 1970-01-01.
+        constexpr inline std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) noexcept {
+            year -= (month <= 2);
+            const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+            const auto yoe = static_cast<unsigned>(year - era * 400);
+            const auto doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+        }
+
+        // Howard Hinnant's civil_from_days(): the inverse of daysFromCivil().
+        template <typename T>
+        constexpr inline void civilFromDays(std::int64_t days, T & date) noexcept {
+            days += 719468;
+            const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            const auto doe = static_cast<unsigned>(days - era * 146097);
+            const auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const auto mp = (5 * doy + 2) / 153;
+            const auto day = doy - (153 * mp + 2) / 5 + 1;
+            const auto month = (mp < 10 ? mp + 3 : mp - 9);
+            date.year = static_cast<decltype(date.year)>(static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2));
+            date.month = static_cast<decltype(date.month)>(month);
+            date.day = static_cast<decltype(date.day)>(day);
+        }
+
+        inline constexpr auto digit_pairs = [] {
+            std::array<char, 200> table{};
+            for (std::size_t i = 0; i < 100; ++i) {
+                table[i * 2] = static_cast<char>('0' + i / 10);
+                table[i * 2 + 1] = static_cast<char>('0' + i % 10);
+            }
+            return table;
+        }();
+
+        inline char * write2Digits(char * out, unsigned value) noexcept {
+            std::memcpy(out, &digit_pairs[value * 2], 2);
+            return out + 2;
+        }
+
+        inline char * write4Digits(char * out, unsigned value) noexcept {
+            out = write2Digits(out, value / 100);
+            return write2Digits(out, value % 100);
+        }
+
+        inline char * write9Digits(char * out, unsigned value) noexcept {
+            *out++ = static_cast<char>('0' + value / 100000000);
+            value %= 100000000;
+            out = write4Digits(out, value / 10000);
+            return write4Digits(out, value % 10000);
+        }
+
+        // Longest output of the formatters below: "YYYY-MM-DD hh:mm:ss.fffffffff".
+        inline constexpr std::size_t max_formatted_size = 29;
+
+        // The fixed-width formatters below are only valid for fields that fit into their columns,
+        // callers are expected to check this and fall back to snprintf() otherwise.
+        inline bool fitsLayout(const SQL_DATE_STRUCT & src) noexcept {
+            return (src.year >= 0 && src.year <= 9999 && src.month <= 99 && src.day <= 99);
+        }
+
+        inline bool fitsLayout(const SQL_TIME_STRUCT & src) noexcept {
+            return (src.hour <= 99 && src.minute <= 99 && src.second <= 99);
+        }
+
+        inline bool fitsLayout(const SQL_TIMESTAMP_STRUCT & src) noexcept {
+            return (
+                src.year >= 0 && src.year <= 9999 && src.month <= 99 && src.day <= 99 &&
+                src.hour <= 99 && src.minute <= 99 && src.second <= 99
+            );
+        }
+
+        template <typename T>
+        inline char * formatDate(char * out, const T & src) noexcept {
+            out = write4Digits(out, src.year);
+            *out++ = '-';
+            out = write2Digits(out, src.month);
+            *out++ = '-';
+            return write2Digits(out, src.day);
+        }
+
+        template <typename T>
+        inline char * formatTime(char * out, const T & src) noexcept {
+            out = write2Digits(out, src.hour);
+            *out++ = ':';
+            out = write2Digits(out, src.minute);
+            *out++ = ':';
+            return write2Digits(out, src.second);
+        }
+
+        inline char * formatTimestamp(char * out, const SQL_TIMESTAMP_STRUCT & src) noexcept {
+            out = formatDate(out, src);
+            *out++ = ' ';
+            out = formatTime(out, src);
+
+            if (src.fraction > 0 && src.fraction < 1000000000) {
+                *out++ = '.';
+                out = write9Digits(out, src.fraction);
+            }
+
+            return out;
+        }
+
+        // Per-position [min, max] byte ranges of "YYYY-MM-DD hh:mm:ss.fffffffff": digits must be in ['0', '9'], separators must match exactly.
+        inline constexpr char layout_min[] = "0000-00-00 00:00:00.000000000";
+        inline constexpr char layout_max[] = "9999-99-99 99:99:99.999999999";
+
+        // Validates the layout of a date ("YYYY-MM-DD") or a date-time ("YYYY-MM-DD hh:mm:ss[.f{1,9}]") string.
+        // Field values themselves are not range-checked here.
+        inline bool isValidLayout(const char * src, std::size_t size) noexcept {
+            if (size != 10 && (size < 19 || size > max_formatted_size))
+                return false;
+
+            std::size_t i = 0;
+            bool valid = true;
+
+#if defined(__SSE2__)
+            if (size >= 16) {
+                const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(layout_min));
+                const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(layout_max));
+                const auto in_range = _mm_and_si128(
+                    _mm_cmpeq_epi8(_mm_max_epu8(value, lo), value),
+                    _mm_cmpeq_epi8(_mm_min_epu8(value, hi), value)
+                );
+                valid = (_mm_movemask_epi8(in_range) == 0xFFFF);
+                i = 16;
+            }
+#endif
+
+            for (; i < size; ++i) {
+                const auto ch = static_cast<unsigned char>(src[i]);
+                valid &= (ch >= static_cast<unsigned char>(layout_min[i]) && ch <= static_cast<unsigned char>(layout_max[i]));
+            }
+
+            return valid;
+        }
+
+        inline unsigned parse2Digits(const char * src) noexcept {
+            return static_cast<unsigned>(src[0] - '0') * 10 + static_cast<unsigned>(src[1] - '0');
+        }
+
+        inline unsigned parse4Digits(const char * src) noexcept {
+            return parse2Digits(src) * 100 + parse2Digits(src + 2);
+        }
+
+        // Parses the fractional part of a validated date-time string, right-padding it with zeroes to nanoseconds.
+        inline SQLUINTEGER parseFraction(const char * src, std::size_t size) noexcept {
+            static constexpr SQLUINTEGER pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+            if (size <= 20)
+                return 0;
+
+            const auto digits = size - 20;
+            SQLUINTEGER fraction = 0;
+            for (std::size_t i = 0; i < digits; ++i) {
+                fraction = fraction * 10 + static_cast<SQLUINTEGER>(src[20 + i] - '0');
+            }
+
+            return fraction * pow10[9 - digits];
+        }
+
+        template <typename T>
+        inline void parseDate(const char * src, T & dest) noexcept {
+            dest.year = parse4Digits(src);
+            dest.month = parse2Digits(src + 5);
+            dest.day = parse2Digits(src + 8);
+        }
+
+        template <typename T>
+        inline void parseTime(const char * src, std::size_t size, T & dest) noexcept {
+            const bool has_time = (size >= 19);
+            dest.hour = has_time ? parse2Digits(src + 11) : 0;
+            dest.minute = has_time ? parse2Digits(src + 14) : 0;
+            dest.second = has_time ? parse2Digits(src + 17) : 0;
+        }
+
+    } // namespace datetime
+
     template <typename ProxyType, typename SourceType, typename DestinationType>
     void convert_via_proxy(const SourceType & src, DestinationType & dest);
 
@@ -1086,13 +1412,10 @@ namespace value_manip {
         using DestinationType = SQL_DATE_STRUCT;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            if (src.size() != 10 && (src.size() < 19 || src.size() > 29))
+            if (!datetime::isValidLayout(src.data(), src.size()))
                 throw std::runtime_error("Cannot interpret '" + src + "' as DATE");
 
-            dest.year = (src[0] - '0') * 1000 + (src[1] - '0') * 100 + (src[2] - '0') * 10 + (src[3] - '0');
-            dest.month = (src[5] - '0') * 10 + (src[6] - '0');
-            dest.day = (src[8] - '0') * 10 + (src[9] - '0');
-
+            datetime::parseDate(src.data(), dest);
             normalize_date(dest);
         }
     };
@@ -1102,19 +1425,10 @@ namespace value_manip {
         using DestinationType = SQL_TIME_STRUCT;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            if (src.size() != 10 && (src.size() < 19 || src.size() > 29))
+            if (!datetime::isValidLayout(src.data(), src.size()))
                 throw std::runtime_error("Cannot interpret '" + src + "' as TIME");
 
-            if (src.size() > 10) {
-                dest.hour = (src[11] - '0') * 10 + (src[12] - '0');
-                dest.minute = (src[14] - '0') * 10 + (src[15] - '0');
-                dest.second = (src[17] - '0') * 10 + (src[18] - '0');
-            }
-            else {
-                dest.hour = 0;
-                dest.minute = 0;
-                dest.second = 0;
-            }
+            datetime::parseTime(src.data(), src.size(), dest);
         }
     };
 
@@ -1123,29 +1437,12 @@ namespace value_manip {
         using DestinationType = SQL_TIMESTAMP_STRUCT;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            if (src.size() != 10 && (src.size() < 19 || src.size() > 29))
+            if (!datetime::isValidLayout(src.data(), src.size()))
                 throw std::runtime_error("Cannot interpret '" + src + "' as TIMESTAMP");
 
-            dest.year = (src[0] - '0') * 1000 + (src[1] - '0') * 100 + (src[2] - '0') * 10 + (src[3] - '0');
-            dest.month = (src[5] - '0') * 10 + (src[6] - '0');
-            dest.day = (src[8] - '0') * 10 + (src[9] - '0');
-
-            if (src.size() >= 19) {
-                dest.hour = (src[11] - '0') * 10 + (src[12] - '0');
-                dest.minute = (src[14] - '0') * 10 + (src[15] - '0');
-                dest.second = (src[17] - '0') * 10 + (src[18] - '0');
-                dest.fraction = 0;
-
-                if (src.size() > 20) {
-                    for (std::size_t i = 20; i < 29; ++i) {
-                        dest.fraction *= 10;
-                        if (i < src.size()) {
-                            dest.fraction += (src[i] - '0');
-                        }
-                    }
-                }
-            }
-
+            datetime::parseDate(src.data(), dest);
+            datetime::parseTime(src.data(), src.size(), dest);
+            dest.fraction = datetime::parseFraction(src.data(), src.size());
             normalize_date(dest);
         }
     };
@@ -1168,7 +1465,7 @@ namespace value_manip {
         using DestinationType = DataSourceType<DataSourceTypeId::Decimal>;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            constexpr auto dest_value_max = (std::numeric_limits<std::decay_t<decltype(dest.value)>>::max)();
+            constexpr auto dest_value_max = decimal::mantissa_max;
             constexpr std::uint32_t dec_mult = 10;
 
             std::size_t left_n = 0;
@@ -1604,14 +1901,11 @@ namespace value_manip {
                 if constexpr (std::is_same_v<SourceType, DestinationType>) {
                     if (src.precision == dest.precision && src.scale == dest.scale) {
                         std::memcpy(&dest, &src, sizeof(dest));
-                    }
-                    else {
-                        convert_via_proxy<DataSourceType<DataSourceTypeId::Decimal>>(src, dest);
+                        return;
                     }
                 }
-                else {
-                    throw std::runtime_error("conversion not supported");
-                }
+
+                convert_via_proxy<DataSourceType<DataSourceTypeId::Decimal>>(src, dest);
             }
         };
     };
@@ -1634,24 +1928,8 @@ namespace value_manip {
             dest.precision = src.precision;
             dest.scale = src.scale;
 
-            constexpr auto dest_max = (std::numeric_limits<decltype(dest.value)>::max)();
-            constexpr std::uint32_t byte_mult = 1 << 8;
-
-            for (std::size_t i = 1; i <= lengthof(src.val); ++i) {
-                const std::uint32_t next_byte_dig = static_cast<unsigned char>(src.val[lengthof(src.val) - i]);
-
-                if (dest.value != 0) {
-                    if ((dest_max / byte_mult) < dest.value)
-                        throw std::runtime_error("Numeric value is too big for internal representation");
-                    dest.value *= byte_mult;
-                }
-
-                if (next_byte_dig != 0) {
-                    if ((dest_max - next_byte_dig) < dest.value)
-                        throw std::runtime_error("Numeric value is too big for internal representation");
-                    dest.value += next_byte_dig;
-                }
-            }
+            if (!decimal::tryLoadMantissa(src, dest.value))
+                throw std::runtime_error("Numeric value is too big for internal representation");
         }
     };
 
@@ -1677,6 +1955,12 @@ namespace value_manip {
         using DestinationType = std::string;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
+            if (datetime::fitsLayout(src)) {
+                char buf[datetime::max_formatted_size];
+                dest.assign(buf, datetime::formatDate(buf, src));
+                return;
+            }
+
             char buf[256];
 
             const auto written = std::snprintf(buf, lengthof(buf), "%04d-%02d-%02d", (int)src.year, (int)src.month, (int)src.day);
@@ -1709,6 +1993,12 @@ namespace value_manip {
         using DestinationType = std::string;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
+            if (datetime::fitsLayout(src)) {
+                char buf[datetime::max_formatted_size];
+                dest.assign(buf, datetime::formatTime(buf, src));
+                return;
+            }
+
             char buf[256];
 
             const auto written = std::snprintf(buf, lengthof(buf), "%02d:%02d:%02d", (int)src.hour, (int)src.minute, (int)src.second);
@@ -1741,6 +2031,12 @@ namespace value_manip {
         using DestinationType = std::string;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
+            if (datetime::fitsLayout(src)) {
+                char buf[datetime::max_formatted_size];
+                dest.assign(buf, datetime::formatTimestamp(buf, src));
+                return;
+            }
+
             char buf[256];
 
             const auto written = std::snprintf(buf, lengthof(buf), "%04d-%02d-%02d %02d:%02d:%02d",
@@ -1796,7 +2092,47 @@ namespace value_manip {
         template <typename DestinationType>
         struct to_value {
             static inline void convert(const SourceType & src, DestinationType & dest) {
-                throw std::runtime_error("conversion not supported");
+                if constexpr (std::is_integral_v<DestinationType>) {
+                    auto int_part = src.value;
+                    decimal::tryRescale(int_part, src.scale, 0); // Never fails when reducing the scale.
+
+                    const bool negative = (src.sign == 0 && int_part != 0);
+                    const DecimalMantissaType dest_max = static_cast<DecimalMantissaType>((std::numeric_limits<DestinationType>::max)());
+
+                    if (negative) {
+                        if constexpr (std::is_signed_v<DestinationType>) {
+                            if (int_part > dest_max + 1)
+                                throw std::runtime_error("Cannot fit source Numeric value into destination integer: value out of range");
+
+                            // Negating in the unsigned domain first avoids overflow when the value is exactly the minimum.
+                            dest = static_cast<DestinationType>(-static_cast<std::make_unsigned_t<DestinationType>>(int_part));
+                        }
+                        else {
+                            throw std::runtime_error("Cannot fit source Numeric value into destination integer: value out of range");
+                        }
+                    }
+                    else {
+                        if (int_part > dest_max)
+                            throw std::runtime_error("Cannot fit source Numeric value into destination integer: value out of range");
+
+                        dest = static_cast<DestinationType>(int_part);
+                    }
+                }
+                else if constexpr (std::is_base_of_v<SourceType, DestinationType>) {
+                    static_cast<SourceType &>(dest) = src;
+                }
+                else if constexpr (std::is_floating_point_v<DestinationType>) {
+                    long double tmp = static_cast<long double>(src.value);
+
+                    for (std::int32_t scale = src.scale; scale > 0; scale -= decimal::max_pow10) {
+                        tmp /= static_cast<long double>(decimal::pow10_table[std::min<std::int32_t>(scale, decimal::max_pow10)]);
+                    }
+
+                    dest = static_cast<DestinationType>(src.sign == 0 ? -tmp : tmp);
+                }
+                else {
+                    throw std::runtime_error("conversion not supported");
+                }
             }
         };
     };
@@ -1806,31 +2142,37 @@ namespace value_manip {
         using DestinationType = std::string;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            dest.reserve(128);
-
-            auto tmp_value = src.value;
-            constexpr std::uint32_t dec_mult = 10;
+            char digits[48];
+            auto * digits_end = digits + lengthof(digits);
+            auto * digits_begin = (src.value == 0 ? digits_end : decimal::writeDigitsBackwards(src.value, digits_end));
 
-            while (tmp_value != 0 || dest.size() < src.scale) {
-                char next_dig = '0';
+            const std::size_t digit_count = digits_end - digits_begin;
+            const std::size_t scale = (src.scale > 0 ? src.scale : 0);
 
-                if (tmp_value != 0) {
-                    next_dig += tmp_value % dec_mult;
-                    tmp_value /= dec_mult;
-                }
+            dest.clear();
+            dest.reserve(digit_count + scale + 3);
 
-                dest.push_back(next_dig);
-
-                if (dest.size() == src.scale)
-                    dest.push_back('.');
+            if (digit_count == 0 && scale == 0) {
+                dest.push_back('0');
+                return;
             }
 
-            if (dest.empty())
-                dest.push_back('0');
-            else if (src.sign == 0 && src.value != 0)
+            if (src.sign == 0 && src.value != 0)
                 dest.push_back('-');
 
-            std::reverse(dest.begin(), dest.end());
+            if (digit_count > scale) {
+                dest.append(digits_begin, digits_end - scale);
+
+                if (scale > 0) {
+                    dest.push_back('.');
+                    dest.append(digits_end - scale, digits_end);
+                }
+            }
+            else {
+                dest.push_back('.');
+                dest.append(scale - digit_count, '0');
+                dest.append(digits_begin, digits_end);
+            }
         }
     };
 
@@ -1847,10 +2189,6 @@ namespace value_manip {
             if (dest.precision < 0 || dest.precision < dest.scale)
                 throw std::runtime_error("Bad Numeric specification");
 
-            constexpr auto src_value_max = (std::numeric_limits<decltype(src.value)>::max)();
-            constexpr std::uint32_t dec_mult = 10;
-            constexpr std::uint32_t byte_mult = 1 << 8;
-
             dest.sign = src.sign;
 
             if (dest.precision == 0) {
@@ -1858,32 +2196,24 @@ namespace value_manip {
                 dest.scale = src.scale;
             }
 
-            auto tmp_src = src;
-
             // Adjust the detected scale if needed.
 
-            while (tmp_src.scale < dest.scale) {
-                if ((src_value_max / dec_mult) < tmp_src.value)
-                    throw std::runtime_error("Cannot fit source Numeric value into destination Numeric specification: value is too big for internal representation");
+            auto value = src.value;
 
-                tmp_src.value *= dec_mult;
-                ++tmp_src.scale;
-            }
-
-            while (dest.scale < tmp_src.scale) {
-                tmp_src.value /= dec_mult;
-                --tmp_src.scale;
-            }
+            if (!decimal::tryRescale(value, src.scale, dest.scale))
+                throw std::runtime_error("Cannot fit source Numeric value into destination Numeric specification: value is too big for internal representation");
 
             // Transfer the value.
 
-            for (std::size_t i = 0; tmp_src.value != 0; ++i) {
-                if (i >= lengthof(dest.val) || i > dest.precision)
-                    throw std::runtime_error("Cannot fit source Numeric value into destination Numeric specification: value is too big for ODBC Numeric representation");
-
-                dest.val[i] = static_cast<std::uint32_t>(tmp_src.value % byte_mult);
-                tmp_src.value /= byte_mult;
+            if (
+                (dest.precision <= static_cast<std::int32_t>(decimal::max_pow10) && value >= decimal::pow10_table[dest.precision]) ||
+                !decimal::tryStoreMantissa(value, dest)
+            ) {
+                throw std::runtime_error("Cannot fit source Numeric value into destination Numeric specification: value is too big for ODBC Numeric representation");
             }
+
+            if (value == 0)
+                dest.sign = 1;
         }
     };
 
@@ -1923,6 +2253,51 @@ namespace value_manip {
         };
     };
 
+    template <>
+    struct from_value<std::int64_t>::to_value<DataSourceType<DataSourceTypeId::Decimal>> {
+        using DestinationType = DataSourceType<DataSourceTypeId::Decimal>;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            // Negating in the unsigned domain avoids overflow for the minimum value.
+            const auto magnitude = (src < 0 ? -static_cast<std::uint64_t>(src) : static_cast<std::uint64_t>(src));
+
+            dest.value = magnitude;
+            dest.sign = (src < 0 ? 0 : 1);
+            dest.precision = decimal::digitCount(magnitude);
+            dest.scale = 0;
+        }
+    };
+
+    template <>
+    struct from_value<std::int64_t>::to_value<SQL_NUMERIC_STRUCT> {
+        using DestinationType = SQL_NUMERIC_STRUCT;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            convert_via_proxy<DataSourceType<DataSourceTypeId::Decimal>>(src, dest);
+        }
+    };
+
+    template <>
+    struct from_value<std::uint64_t>::to_value<DataSourceType<DataSourceTypeId::Decimal>> {
+        using DestinationType = DataSourceType<DataSourceTypeId::Decimal>;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            dest.value = src;
+            dest.sign = 1;
+            dest.precision = decimal::digitCount(src);
+            dest.scale = 0;
+        }
+    };
+
+    template <>
+    struct from_value<std::uint64_t>::to_value<SQL_NUMERIC_STRUCT> {
+        using DestinationType = SQL_NUMERIC_STRUCT;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            convert_via_proxy<DataSourceType<DataSourceTypeId::Decimal>>(src, dest);
+        }
+    };
+
     template <>
     struct from_value<WireTypeAnyAsString> {
         using SourceType = WireTypeAnyAsString;
@@ -1952,19 +2327,8 @@ namespace value_manip {
         using DestinationType = DataSourceType<DataSourceTypeId::Date>;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            std::tm tm = {};
-
-            {
-                // TODO: convert time according to src.timezone
-
-                std::time_t time = src.value;
-                time = time * 24 * 60 * 60; // Now it's seconds since epoch.
-                toLocalTime(time, tm);
-            }
-
-            dest.value.year = 1900 + tm.tm_year;
-            dest.value.month = 1 + tm.tm_mon;
-            dest.value.day = tm.tm_mday;
+            // Date is a plain day number since the epoch, there is no time zone to apply to it.
+            datetime::civilFromDays(src.value, dest.value);
         }
     };
 
@@ -2421,86 +2785,230 @@ inline auto getCTypeOctetLength(SQLSMALLINT c_type) {
     }
 }
 
-template <typename T>
-inline auto readReadyDataTo(const BindingInfo & src, T & dest) {
-    switch (src.c_type) {
-        case SQL_C_CHAR:           return value_manip::from_buffer< char *               >::template to_value< T >::convert(src, dest);
-        case SQL_C_WCHAR:          return value_manip::from_buffer< char16_t *           >::template to_value< T >::convert(src, dest);
-        case SQL_C_BIT:            return value_manip::from_buffer< SQLCHAR              >::template to_value< T >::convert(src, dest);
-        case SQL_C_TINYINT:        return value_manip::from_buffer< SQLSCHAR             >::template to_value< T >::convert(src, dest);
-        case SQL_C_STINYINT:       return value_manip::from_buffer< SQLSCHAR             >::template to_value< T >::convert(src, dest);
-        case SQL_C_UTINYINT:       return value_manip::from_buffer< SQLCHAR              >::template to_value< T >::convert(src, dest);
-        case SQL_C_SHORT:          return value_manip::from_buffer< SQLSMALLINT          >::template to_value< T >::convert(src, dest);
-        case SQL_C_SSHORT:         return value_manip::from_buffer< SQLSMALLINT          >::template to_value< T >::convert(src, dest);
-        case SQL_C_USHORT:         return value_manip::from_buffer< SQLUSMALLINT         >::template to_value< T >::convert(src, dest);
-        case SQL_C_LONG:           return value_manip::from_buffer< SQLINTEGER           >::template to_value< T >::convert(src, dest);
-        case SQL_C_SLONG:          return value_manip::from_buffer< SQLINTEGER           >::template to_value< T >::convert(src, dest);
-        case SQL_C_ULONG:          return value_manip::from_buffer< SQLUINTEGER          >::template to_value< T >::convert(src, dest);
-        case SQL_C_SBIGINT:        return value_manip::from_buffer< SQLBIGINT            >::template to_value< T >::convert(src, dest);
-        case SQL_C_UBIGINT:        return value_manip::from_buffer< SQLUBIGINT           >::template to_value< T >::convert(src, dest);
-        case SQL_C_FLOAT:          return value_manip::from_buffer< SQLREAL              >::template to_value< T >::convert(src, dest);
-        case SQL_C_DOUBLE:         return value_manip::from_buffer< SQLDOUBLE            >::template to_value< T >::convert(src, dest);
-        case SQL_C_BINARY:         return value_manip::from_buffer< char *               >::template to_value< T >::convert(src, dest);
-        case SQL_C_GUID:           return value_manip::from_buffer< SQLGUID              >::template to_value< T >::convert(src, dest);
-
-//      case SQL_C_BOOKMARK:       return value_manip::from_buffer< BOOKMARK             >::template to_value< T >::convert(src, dest);
-//      case SQL_C_VARBOOKMARK:    return value_manip::from_buffer< SQLCHAR *            >::template to_value< T >::convert(src, dest);
-
-        case SQL_C_NUMERIC:        return value_manip::from_buffer< SQL_NUMERIC_STRUCT   >::template to_value< T >::convert(src, dest);
+namespace value_manip {
+namespace dispatch {
+
+    // Distinct C type representations that bound buffers can hold. Several C types may share one (e.g., SQL_C_CHAR and SQL_C_BINARY).
+    // Position in this list is the "C type ordinal", the column index of the dispatch tables below.
+    using CTypeRepresentations = std::tuple<
+        char *,
+        char16_t *,
+        SQLCHAR,
+        SQLSCHAR,
+        SQLSMALLINT,
+        SQLUSMALLINT,
+        SQLINTEGER,
+        SQLUINTEGER,
+        SQLBIGINT,
+        SQLUBIGINT,
+        SQLREAL,
+        SQLDOUBLE,
+        SQLGUID,
+        SQL_NUMERIC_STRUCT,
+        SQL_DATE_STRUCT,
+        SQL_TIME_STRUCT,
+        SQL_TIMESTAMP_STRUCT
+    >;
 
-        case SQL_C_DATE:
-        case SQL_C_TYPE_DATE:      return value_manip::from_buffer< SQL_DATE_STRUCT      >::template to_value< T >::convert(src, dest);
+    inline constexpr std::size_t c_type_count = std::tuple_size_v<CTypeRepresentations>;
+    inline constexpr std::size_t c_type_unsupported = c_type_count;
 
-        case SQL_C_TIME:
-        case SQL_C_TYPE_TIME:      return value_manip::from_buffer< SQL_TIME_STRUCT      >::template to_value< T >::convert(src, dest);
+    template <typename T, std::size_t... Is>
+    constexpr std::size_t indexOfCType(std::index_sequence<Is...>) {
+        std::size_t index = c_type_unsupported;
+        ((std::is_same_v<T, std::tuple_element_t<Is, CTypeRepresentations>> ? (index = Is, true) : false) || ...);
+        return index;
+    }
 
-        case SQL_C_TIMESTAMP:
-        case SQL_C_TYPE_TIMESTAMP: return value_manip::from_buffer< SQL_TIMESTAMP_STRUCT >::template to_value< T >::convert(src, dest);
+    template <typename T>
+    inline constexpr std::size_t c_type_ordinal_of = indexOfCType<T>(std::make_index_sequence<c_type_count>{});
+
+    constexpr std::size_t getCTypeOrdinalSlow(SQLSMALLINT c_type) {
+        switch (c_type) {
+            case SQL_C_CHAR:           return c_type_ordinal_of< char *               >;
+            case SQL_C_WCHAR:          return c_type_ordinal_of< char16_t *           >;
+            case SQL_C_BIT:            return c_type_ordinal_of< SQLCHAR              >;
+            case SQL_C_TINYINT:        return c_type_ordinal_of< SQLSCHAR             >;
+            case SQL_C_STINYINT:       return c_type_ordinal_of< SQLSCHAR             >;
+            case SQL_C_UTINYINT:       return c_type_ordinal_of< SQLCHAR              >;
+            case SQL_C_SHORT:          return c_type_ordinal_of< SQLSMALLINT          >;
+            case SQL_C_SSHORT:         return c_type_ordinal_of< SQLSMALLINT          >;
+            case SQL_C_USHORT:         return c_type_ordinal_of< SQLUSMALLINT         >;
+            case SQL_C_LONG:           return c_type_ordinal_of< SQLINTEGER           >;
+            case SQL_C_SLONG:          return c_type_ordinal_of< SQLINTEGER           >;
+            case SQL_C_ULONG:          return c_type_ordinal_of< SQLUINTEGER          >;
+            case SQL_C_SBIGINT:        return c_type_ordinal_of< SQLBIGINT            >;
+            case SQL_C_UBIGINT:        return c_type_ordinal_of< SQLUBIGINT           >;
+            case SQL_C_FLOAT:          return c_type_ordinal_of< SQLREAL              >;
+            case SQL_C_DOUBLE:         return c_type_ordinal_of< SQLDOUBLE            >;
+            case SQL_C_BINARY:         return c_type_ordinal_of< char *               >;
+            case SQL_C_GUID:           return c_type_ordinal_of< SQLGUID              >;
+
+//          case SQL_C_BOOKMARK:
+//          case SQL_C_VARBOOKMARK:
+
+            case SQL_C_NUMERIC:        return c_type_ordinal_of< SQL_NUMERIC_STRUCT   >;
+
+            case SQL_C_DATE:
+            case SQL_C_TYPE_DATE:      return c_type_ordinal_of< SQL_DATE_STRUCT      >;
+
+            case SQL_C_TIME:
+            case SQL_C_TYPE_TIME:      return c_type_ordinal_of< SQL_TIME_STRUCT      >;
+
+            case SQL_C_TIMESTAMP:
+            case SQL_C_TYPE_TIMESTAMP: return c_type_ordinal_of< SQL_TIMESTAMP_STRUCT >;
+
+            default:                   return c_type_unsupported;
+        }
+    }
 
-        default:
-            throw std::runtime_error("Unable to extract data from bound buffer: source type representation not supported");
+    inline constexpr SQLSMALLINT c_type_codes[] = {
+        SQL_C_CHAR, SQL_C_WCHAR, SQL_C_BIT, SQL_C_TINYINT, SQL_C_STINYINT, SQL_C_UTINYINT, SQL_C_SHORT, SQL_C_SSHORT,
+        SQL_C_USHORT, SQL_C_LONG, SQL_C_SLONG, SQL_C_ULONG, SQL_C_SBIGINT, SQL_C_UBIGINT, SQL_C_FLOAT, SQL_C_DOUBLE,
+        SQL_C_BINARY, SQL_C_GUID, SQL_C_NUMERIC, SQL_C_DATE, SQL_C_TYPE_DATE, SQL_C_TIME, SQL_C_TYPE_TIME,
+        SQL_C_TIMESTAMP, SQL_C_TYPE_TIMESTAMP
+    };
+
+    // All supported C type codes fall into a narrow range ([-28, 93] in the standard headers), so a dense lookup table covers them.
+    inline constexpr SQLSMALLINT c_type_table_min = *std::min_element(std::begin(c_type_codes), std::end(c_type_codes));
+    inline constexpr SQLSMALLINT c_type_table_max = *std::max_element(std::begin(c_type_codes), std::end(c_type_codes));
+
+    inline constexpr auto c_type_ordinals = [] {
+        std::array<std::uint8_t, c_type_table_max - c_type_table_min + 1> table{};
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            table[i] = static_cast<std::uint8_t>(getCTypeOrdinalSlow(static_cast<SQLSMALLINT>(c_type_table_min + i)));
+        }
+        return table;
+    }();
+
+    constexpr inline std::size_t getCTypeOrdinal(SQLSMALLINT c_type) {
+        if (c_type < c_type_table_min || c_type > c_type_table_max)
+            return c_type_unsupported;
+
+        return c_type_ordinals[c_type - c_type_table_min];
     }
+
+    template <typename CType>
+    inline constexpr bool is_string_c_type_v = (std::is_same_v<CType, char *> || std::is_same_v<CType, char16_t *>);
+
+    template <typename CType, typename T, typename ConversionContext>
+    inline SQLRETURN writeAs(const T & src, BindingInfo & dest, ConversionContext & context) {
+        if constexpr (std::is_same_v<T, DataSourceType<DataSourceTypeId::Nothing>>)
+            return fillOutputNULL(dest.value, dest.value_max_size, dest.indicator);
+        else if constexpr (is_string_c_type_v<CType>)
+            return to_buffer<CType>::template from_value<T>::convert(src, dest, context);
+        else
+            return to_buffer<CType>::template from_value<T>::convert(src, dest);
+    }
+
+    template <typename CType, typename T>
+    inline void readAs(const BindingInfo & src, T & dest) {
+        from_buffer<CType>::template to_value<T>::convert(src, dest);
+    }
+
+    // Write table for a single source type: [C type ordinal] -> function.
+    template <typename T, typename ConversionContext>
+    struct WriteRow {
+        using Function = SQLRETURN (*)(const T & src, BindingInfo & dest, ConversionContext & context);
+
+        template <std::size_t... Js>
+        static constexpr std::array<Function, c_type_count> make(std::index_sequence<Js...>) {
+            return { &writeAs<std::tuple_element_t<Js, CTypeRepresentations>, T, ConversionContext>... };
+        }
+
+        static constexpr auto table = make(std::make_index_sequence<c_type_count>{});
+    };
+
+    // Write table for a variant of source types: [variant index][C type ordinal] -> function, replaces std::visit + switch.
+    template <typename Variant, typename ConversionContext>
+    struct WriteVariantTable; // Leave unimplemented for general case.
+
+    template <typename... Ts, typename ConversionContext>
+    struct WriteVariantTable<std::variant<Ts...>, ConversionContext> {
+        using Variant = std::variant<Ts...>;
+        using Function = SQLRETURN (*)(const Variant & src, BindingInfo & dest, ConversionContext & context);
+
+        template <std::size_t I, typename CType>
+        static SQLRETURN write(const Variant & src, BindingInfo & dest, ConversionContext & context) {
+            return writeAs<CType>(*std::get_if<I>(&src), dest, context);
+        }
+
+        template <std::size_t I, std::size_t... Js>
+        static constexpr std::array<Function, c_type_count> makeRow(std::index_sequence<Js...>) {
+            return { &write<I, std::tuple_element_t<Js, CTypeRepresentations>>... };
+        }
+
+        template <std::size_t... Is>
+        static constexpr std::array<std::array<Function, c_type_count>, sizeof...(Is)> make(std::index_sequence<Is...>) {
+            return { makeRow<Is>(std::make_index_sequence<c_type_count>{})... };
+        }
+
+        static constexpr auto table = make(std::index_sequence_for<Ts...>{});
+    };
+
+    // Read table for a single destination type: [C type ordinal] -> function.
+    template <typename T>
+    struct ReadRow {
+        using Function = void (*)(const BindingInfo & src, T & dest);
+
+        template <std::size_t... Js>
+        static constexpr std::array<Function, c_type_count> make(std::index_sequence<Js...>) {
+            return { &readAs<std::tuple_element_t<Js, CTypeRepresentations>, T>... };
+        }
+
+        static constexpr auto table = make(std::make_index_sequence<c_type_count>{});
+    };
+
+} // namespace dispatch
+} // namespace value_manip
+
+template <typename T>
+inline void readReadyDataTo(const BindingInfo & src, T & dest) {
+    const auto c_type_ordinal = value_manip::dispatch::getCTypeOrdinal(src.c_type);
+
+    if (c_type_ordinal == value_manip::dispatch::c_type_unsupported)
+        throw std::runtime_error("Unable to extract data from bound buffer: source type representation not supported");
+
+    return value_manip::dispatch::ReadRow<T>::table[c_type_ordinal](src, dest);
+}
+
+// The function that readReadyDataTo() calls for the C type, or nullptr, if the C type is not supported.
+// Allows resolving it once for many values of the same binding.
+template <typename T>
+inline typename value_manip::dispatch::ReadRow<T>::Function getReadyDataReader(SQLSMALLINT c_type) {
+    const auto c_type_ordinal = value_manip::dispatch::getCTypeOrdinal(c_type);
+
+    if (c_type_ordinal == value_manip::dispatch::c_type_unsupported)
+        return nullptr;
+
+    return value_manip::dispatch::ReadRow<T>::table[c_type_ordinal];
 }
 
 template <typename T, typename ConversionContext>
-inline auto writeDataFrom(const T & src, BindingInfo & dest, ConversionContext && context) {
-    switch (dest.c_type) {
-        case SQL_C_CHAR:           return value_manip::to_buffer< char *               >::template from_value< T >::convert(src, dest, std::forward<ConversionContext>(context));
-        case SQL_C_WCHAR:          return value_manip::to_buffer< char16_t *           >::template from_value< T >::convert(src, dest, std::forward<ConversionContext>(context));
-        case SQL_C_BIT:            return value_manip::to_buffer< SQLCHAR              >::template from_value< T >::convert(src, dest);
-        case SQL_C_TINYINT:        return value_manip::to_buffer< SQLSCHAR             >::template from_value< T >::convert(src, dest);
-        case SQL_C_STINYINT:       return value_manip::to_buffer< SQLSCHAR             >::template from_value< T >::convert(src, dest);
-        case SQL_C_UTINYINT:       return value_manip::to_buffer< SQLCHAR              >::template from_value< T >::convert(src, dest);
-        case SQL_C_SHORT:          return value_manip::to_buffer< SQLSMALLINT          >::template from_value< T >::convert(src, dest);
-        case SQL_C_SSHORT:         return value_manip::to_buffer< SQLSMALLINT          >::template from_value< T >::convert(src, dest);
-        case SQL_C_USHORT:         return value_manip::to_buffer< SQLUSMALLINT         >::template from_value< T >::convert(src, dest);
-        case SQL_C_LONG:           return value_manip::to_buffer< SQLINTEGER           >::template from_value< T >::convert(src, dest);
-        case SQL_C_SLONG:          return value_manip::to_buffer< SQLINTEGER           >::template from_value< T >::convert(src, dest);
-        case SQL_C_ULONG:          return value_manip::to_buffer< SQLUINTEGER          >::template from_value< T >::convert(src, dest);
-        case SQL_C_SBIGINT:        return value_manip::to_buffer< SQLBIGINT            >::template from_value< T >::convert(src, dest);
-        case SQL_C_UBIGINT:        return value_manip::to_buffer< SQLUBIGINT           >::template from_value< T >::convert(src, dest);
-        case SQL_C_FLOAT:          return value_manip::to_buffer< SQLREAL              >::template from_value< T >::convert(src, dest);
-        case SQL_C_DOUBLE:         return value_manip::to_buffer< SQLDOUBLE            >::template from_value< T >::convert(src, dest);
-        case SQL_C_BINARY:         return value_manip::to_buffer< char *               >::template from_value< T >::convert(src, dest, std::forward<ConversionContext>(context));
-        case SQL_C_GUID:           return value_manip::to_buffer< SQLGUID              >::template from_value< T >::convert(src, dest);
-
-//      case SQL_C_BOOKMARK:       return value_manip::to_buffer< BOOKMARK             >::template from_value< T >::convert(src, dest);
-//      case SQL_C_VARBOOKMARK:    return value_manip::to_buffer< SQLCHAR *            >::template from_value< T >::convert(src, dest);
-
-        case SQL_C_NUMERIC:        return value_manip::to_buffer< SQL_NUMERIC_STRUCT   >::template from_value< T >::convert(src, dest);
+inline SQLRETURN writeDataFrom(const T & src, BindingInfo & dest, ConversionContext && context) {
+    const auto c_type_ordinal = value_manip::dispatch::getCTypeOrdinal(dest.c_type);
 
-        case SQL_C_DATE:
-        case SQL_C_TYPE_DATE:      return value_manip::to_buffer< SQL_DATE_STRUCT      >::template from_value< T >::convert(src, dest);
+    if (c_type_ordinal == value_manip::dispatch::c_type_unsupported)
+        throw std::runtime_error("Unable to write data into bound buffer: destination type representation not supported");
 
-        case SQL_C_TIME:
-        case SQL_C_TYPE_TIME:      return value_manip::to_buffer< SQL_TIME_STRUCT      >::template from_value< T >::convert(src, dest);
+    using Row = value_manip::dispatch::WriteRow<T, std::remove_reference_t<ConversionContext>>;
+    return Row::table[c_type_ordinal](src, dest, context);
+}
 
-        case SQL_C_TIMESTAMP:
-        case SQL_C_TYPE_TIMESTAMP: return value_manip::to_buffer< SQL_TIMESTAMP_STRUCT >::template from_value< T >::convert(src, dest);
+// Writes the currently held alternative of a variant, with a single indexed call instead of a std::visit + switch pair.
+// DataSourceType<DataSourceTypeId::Nothing> alternative is written as NULL.
+template <typename... Ts, typename ConversionContext>
+inline SQLRETURN writeDataFrom(const std::variant<Ts...> & src, BindingInfo & dest, ConversionContext && context) {
+    const auto c_type_ordinal = value_manip::dispatch::getCTypeOrdinal(dest.c_type);
 
-        default:
-            throw std::runtime_error("Unable to write data into bound buffer: destination type representation not supported");
-    }
+    if (c_type_ordinal == value_manip::dispatch::c_type_unsupported)
+        throw std::runtime_error("Unable to write data into bound buffer: destination type representation not supported");
+
+    if (src.valueless_by_exception())
+        throw std::runtime_error("Unable to write data into bound buffer: source value is not initialized");
+
+    using Table = value_manip::dispatch::WriteVariantTable<std::variant<Ts...>, std::remove_reference_t<ConversionContext>>;
+    return Table::table[src.index()][c_type_ordinal](src, dest, context);
 }
 
 inline std::string toSqlQueryValue(UnsignedAttribute attr)
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Unsigned 128-bit integer with the semantics of unsigned __int128 (wrapping arithmetic, truncating conversions),
+// for compilers that don't have one, e.g., MSVC. Only the operations the Decimal/Numeric conversions need are implemented.
+// The low half is stored first, so that the memory layout matches that of a little-endian 128-bit integer.
+class UInt128 {
+public:
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+
+public:
+    constexpr UInt128() = default;
+
+    constexpr UInt128(std::uint64_t high_, std::uint64_t low_)
+        : low(low_)
+        , high(high_)
+    {
+    }
+
+    // Negative values are sign-extended, as in the conversion of a signed integer to an unsigned one.
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    constexpr UInt128(T value)
+        : low(static_cast<std::uint64_t>(value))
+        , high(std::is_signed_v<T> && value < 0 ? ~std::uint64_t{0} : 0)
+    {
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    explicit constexpr operator T() const {
+        if constexpr (std::is_same_v<T, bool>)
+            return (low != 0 || high != 0);
+        else
+            return static_cast<T>(low);
+    }
+
+    explicit constexpr operator long double() const {
+        return static_cast<long double>(high) * 18446744073709551616.0L + static_cast<long double>(low);
+    }
+
+    explicit constexpr operator double() const {
+        return static_cast<double>(static_cast<long double>(*this));
+    }
+
+    friend constexpr bool operator== (const UInt128 & left, const UInt128 & right) {
+        return (left.high == right.high && left.low == right.low);
+    }
+
+    friend constexpr bool operator!= (const UInt128 & left, const UInt128 & right) {
+        return !(left == right);
+    }
+
+    friend constexpr bool operator< (const UInt128 & left, const UInt128 & right) {
+        return (left.high != right.high ? left.high < right.high : left.low < right.low);
+    }
+
+    friend constexpr bool operator> (const UInt128 & left, const UInt128 & right) {
+        return (right < left);
+    }
+
+    friend constexpr bool operator<= (const UInt128 & left, const UInt128 & right) {
+        return !(right < left);
+    }
+
+    friend constexpr bool operator>= (const UInt128 & left, const UInt128 & right) {
+        return !(left < right);
+    }
+
+    friend constexpr UInt128 operator~ (const UInt128 & value) {
+        return UInt128(~value.high, ~value.low);
+    }
+
+    friend constexpr UInt128 operator- (const UInt128 & value) {
+        return ~value + 1;
+    }
+
+    friend constexpr UInt128 operator& (const UInt128 & left, const UInt128 & right) {
+        return UInt128(left.high & right.high, left.low & right.low);
+    }
+
+    friend constexpr UInt128 operator| (const UInt128 & left, const UInt128 & right) {
+        return UInt128(left.high | right.high, left.low | right.low);
+    }
+
+    friend constexpr UInt128 operator<< (const UInt128 & value, unsigned int shift) {
+        shift &= 127;
+        if (shift == 0)
+            return value;
+        if (shift >= 64)
+            return UInt128(value.low << (shift - 64), 0);
+        return UInt128((value.high << shift) | (value.low >> (64 - shift)), value.low << shift);
+    }
+
+    friend constexpr UInt128 operator>> (const UInt128 & value, unsigned int shift) {
+        shift &= 127;
+        if (shift == 0)
+            return value;
+        if (shift >= 64)
+            return UInt128(0, value.high >> (shift - 64));
+        return UInt128(value.high >> shift, (value.low >> shift) | (value.high << (64 - shift)));
+    }
+
+    friend constexpr UInt128 operator+ (const UInt128 & left, const UInt128 & right) {
+        const auto low = left.low + right.low;
+        return UInt128(left.high + right.high + (low < left.low ? 1 : 0), low);
+    }
+
+    friend constexpr UInt128 operator- (const UInt128 & left, const UInt128 & right) {
+        return UInt128(left.high - right.high - (left.low < right.low ? 1 : 0), left.low - right.low);
+    }
+
+    friend constexpr UInt128 operator* (const UInt128 & left, const UInt128 & right) {
+        // The full 128-bit product of the low halves, from their 32-bit parts, the rest only contributes to the high half.
+        const std::uint64_t a0 = left.low & 0xFFFFFFFF;
+        const std::uint64_t a1 = left.low >> 32;
+        const std::uint64_t b0 = right.low & 0xFFFFFFFF;
+        const std::uint64_t b1 = right.low >> 32;
+
+        const auto p00 = a0 * b0;
+        const auto p01 = a0 * b1;
+        const auto p10 = a1 * b0;
+        const auto p11 = a1 * b1;
+
+        const auto middle = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+        const auto low = (middle << 32) | (p00 & 0xFFFFFFFF);
+        const auto high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32) + left.low * right.high + left.high * right.low;
+
+        return UInt128(high, low);
+    }
+
+    friend constexpr UInt128 operator/ (const UInt128 & left, const UInt128 & right) {
+        UInt128 quotient;
+        UInt128 remainder;
+        divMod(left, right, quotient, remainder);
+        return quotient;
+    }
+
+    friend constexpr UInt128 operator% (const UInt128 & left, const UInt128 & right) {
+        UInt128 quotient;
+        UInt128 remainder;
+        divMod(left, right, quotient, remainder);
+        return remainder;
+    }
+
+    constexpr UInt128 & operator+= (const UInt128 & other) { return *this = *this + other; }
+    constexpr UInt128 & operator-= (const UInt128 & other) { return *this = *this - other; }
+    constexpr UInt128 & operator*= (const UInt128 & other) { return *this = *this * other; }
+    constexpr UInt128 & operator/= (const UInt128 & other) { return *this = *this / other; }
+    constexpr UInt128 & operator%= (const UInt128 & other) { return *this = *this % other; }
+    constexpr UInt128 & operator&= (const UInt128 & other) { return *this = *this & other; }
+    constexpr UInt128 & operator|= (const UInt128 & other) { return *this = *this | other; }
+    constexpr UInt128 & operator<<= (unsigned int shift) { return *this = *this << shift; }
+    constexpr UInt128 & operator>>= (unsigned int shift) { return *this = *this >> shift; }
+
+    // Divide with the remainder. The divisor must not be 0.
+    static constexpr void divMod(const UInt128 & dividend, const UInt128 & divisor, UInt128 & quotient, UInt128 & remainder) {
+        // Divisors up to 32 bits (e.g., 10 or 10^9) are the common case, and are handled by the schoolbook division of 32-bit digits.
+        if (divisor.high == 0 && (divisor.low >> 32) == 0) {
+            const std::uint32_t digits[4] = {
+                static_cast<std::uint32_t>(dividend.high >> 32), static_cast<std::uint32_t>(dividend.high),
+                static_cast<std::uint32_t>(dividend.low >> 32), static_cast<std::uint32_t>(dividend.low)
+            };
+
+            std::uint64_t quotient_digits[4] = {};
+            std::uint64_t rest = 0;
+            for (std::size_t i = 0; i < 4; ++i) {
+                const auto current = (rest << 32) | digits[i];
+                quotient_digits[i] = current / divisor.low;
+                rest = current % divisor.low;
+            }
+
+            quotient = UInt128((quotient_digits[0] << 32) | quotient_digits[1], (quotient_digits[2] << 32) | quotient_digits[3]);
+            remainder = UInt128(0, rest);
+            return;
+        }
+
+        quotient = 0;
+        remainder = dividend;
+
+        if (dividend < divisor)
+            return;
+
+        // Binary long division, starting with the divisor aligned to the most significant bit of the dividend.
+        const auto shift = static_cast<unsigned int>(countLeadingZeros(divisor) - countLeadingZeros(dividend));
+        auto shifted_divisor = divisor << shift;
+
+        for (unsigned int i = 0; i <= shift; ++i) {
+            quotient <<= 1;
+            if (remainder >= shifted_divisor) {
+                remainder -= shifted_divisor;
+                quotient.low |= 1;
+            }
+            shifted_divisor >>= 1;
+        }
+    }
+
+private:
+    static constexpr int countLeadingZeros(const UInt128 & value) {
+        return (value.high != 0 ? std::countl_zero(value.high) : 64 + std::countl_zero(value.low));
+    }
+};
+
+static_assert(sizeof(UInt128) == 16, "UInt128 must have the size and layout of a 128-bit integer");
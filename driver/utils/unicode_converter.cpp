@@ -178,7 +178,26 @@ UnicodeConverter::UnicodeConverter(const std::string & encoding) {
         pivot_signature_to_prepend_ = (isLittleEndian() ? make_raw_str({ 0xFF, 0xFE }) : make_raw_str({ 0xFE, 0xFF }));
         pivot_signatures_to_trim_.push_back(pivot_signature_to_prepend_);
         pivot_signatures_to_trim_max_size_ = pivot_signature_to_prepend_.size();
+
+        // Precompute the first bytes of all signatures, so that the common no-signature case is rejected by a single lookup.
+        for (auto & signature : encoded_signatures_to_trim_) {
+            if (!signature.empty())
+                encoded_signatures_to_trim_first_bytes_.set(static_cast<unsigned char>(signature.front()));
+        }
+
+        for (auto & signature : pivot_signatures_to_trim_) {
+            if (!signature.empty())
+                pivot_signatures_to_trim_first_bytes_.set(static_cast<unsigned char>(signature.front()));
+        }
     }
+
+    // UTF-16/UCS-2 without byte order meta-info are in the native byte order (see above), and so is the pivot.
+    is_pivot_encoding_ = (
+        sameEncoding(encoding, converter_pivot_wide_char_encoding) ||
+        sameEncoding(encoding, "UCS-2") ||
+        sameEncoding(encoding, (isLittleEndian() ? "UTF-16LE" : "UTF-16BE")) ||
+        sameEncoding(encoding, (isLittleEndian() ? "UCS-2LE" : "UCS-2BE"))
+    );
 }
 
 UnicodeConverter::~UnicodeConverter() {
@@ -2,10 +2,12 @@
 
 #include "driver/platform/platform.h"
 #include "driver/utils/utils.h"
+#include "driver/utils/resize_without_initialization.h"
 
 #include <unicode/ustring.h>
 #include <unicode/ucnv.h>
 
+#include <bitset>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -83,6 +85,9 @@ public:
 
     inline const std::size_t getEncodedMinCharSize() const;
 
+    // True if the encoding of this converter is bit-compatible with the ICU's pivot, i.e., UTF-16 in the native byte order.
+    inline bool isPivotEncoding() const;
+
     template <typename CharType>
     inline std::basic_string_view<CharType> consumeEncodedSignature(const std::basic_string_view<CharType> & str) const;
 
@@ -126,19 +131,33 @@ private:
     std::string encoded_signature_to_prepend_;
     std::vector<std::string> encoded_signatures_to_trim_;
     std::size_t encoded_signatures_to_trim_max_size_ = 0;
+    std::bitset<256> encoded_signatures_to_trim_first_bytes_;
 
     std::string pivot_signature_to_prepend_;
     std::vector<std::string> pivot_signatures_to_trim_;
     std::size_t pivot_signatures_to_trim_max_size_ = 0;
+    std::bitset<256> pivot_signatures_to_trim_first_bytes_;
+
+    bool is_pivot_encoding_ = false;
 };
 
+// Quick rejection test: true if the first byte of the string can't start any of the signatures in the set.
+template <typename CharType>
+inline bool cannotStartWithSignature(const std::basic_string_view<CharType> & str, const std::bitset<256> & signature_first_bytes) {
+    return (str.empty() || !signature_first_bytes[*reinterpret_cast<const unsigned char *>(str.data())]);
+}
+
 inline const std::size_t UnicodeConverter::getEncodedMinCharSize() const {
     return ucnv_getMinCharSize(converter_);
 }
 
+inline bool UnicodeConverter::isPivotEncoding() const {
+    return is_pivot_encoding_;
+}
+
 template <typename CharType>
 inline std::basic_string_view<CharType> UnicodeConverter::consumeEncodedSignature(const std::basic_string_view<CharType> & str) const {
-    if (!str.empty()) {
+    if (!cannotStartWithSignature(str, encoded_signatures_to_trim_first_bytes_)) {
         for (auto & signature : encoded_signatures_to_trim_) {
             auto str_no_sig = ::consumeSignature(str, make_string_view(signature));
             if (str_no_sig.size() < str.size())
@@ -151,7 +170,7 @@ inline std::basic_string_view<CharType> UnicodeConverter::consumeEncodedSignatur
 
 template <typename CharType>
 inline std::basic_string_view<CharType> UnicodeConverter::consumePivotSignature(const std::basic_string_view<CharType> & str) const {
-    if (!str.empty()) {
+    if (!cannotStartWithSignature(str, pivot_signatures_to_trim_first_bytes_)) {
         for (auto & signature : pivot_signatures_to_trim_) {
             auto str_no_sig = ::consumeSignature(str, make_string_view(signature));
             if (str_no_sig.size() < str.size())
@@ -164,7 +183,7 @@ inline std::basic_string_view<CharType> UnicodeConverter::consumePivotSignature(
 
 template <typename CharType>
 inline std::size_t UnicodeConverter::consumeEncodedSignatureInPlace(std::basic_string<CharType> & str) const {
-    if (!str.empty()) {
+    if (!cannotStartWithSignature(make_string_view(str), encoded_signatures_to_trim_first_bytes_)) {
         for (auto & signature : encoded_signatures_to_trim_) {
             const auto symbols_consumed = ::consumeSignatureInPlace(str, make_string_view(signature));
             if (symbols_consumed > 0)
@@ -177,7 +196,7 @@ inline std::size_t UnicodeConverter::consumeEncodedSignatureInPlace(std::basic_s
 
 template <typename CharType>
 inline std::size_t UnicodeConverter::consumePivotSignatureInPlace(std::basic_string<CharType> & str) const {
-    if (!str.empty()) {
+    if (!cannotStartWithSignature(make_string_view(str), pivot_signatures_to_trim_first_bytes_)) {
         for (auto & signature : pivot_signatures_to_trim_) {
             const auto symbols_consumed = ::consumeSignatureInPlace(str, make_string_view(signature));
             if (symbols_consumed > 0)
@@ -244,7 +263,7 @@ inline void UnicodeConverter::convertToPivot(
         bool pivot_signature_trimmed = false;
 
         // If signature must be prepended to the encoded string before decoding, we feed it to ucnv_toUnicode() separately, to avoid heavy copying.
-        if (ensure_encoded_signature) {
+        if (ensure_encoded_signature && !encoded_signature_to_prepend_.empty()) {
             auto encoded_no_sig = consumeEncodedSignature(encoded);
             if (encoded_no_sig.size() == encoded.size()) {
                 auto * target_prev = target;
@@ -482,6 +501,28 @@ inline void convertEncoding(
     const bool ensure_src_signature,
     const bool trim_dest_signature
 ) {
+    // Direct paths: if either side is already in the pivot encoding, a single ICU conversion (or none at all) is enough.
+    if constexpr (sizeof(SourceCharType) == sizeof(ConverterPivotWideCharType)) {
+        if (src_converter.isPivotEncoding()) {
+            if constexpr (sizeof(DestinationCharType) == sizeof(ConverterPivotWideCharType)) {
+                if (dest_converter.isPivotEncoding()) {
+                    const auto src_no_sig = (trim_dest_signature ? src_converter.consumePivotSignature(src) : src);
+                    resize_without_initialization(dest, src_no_sig.size());
+                    if (!src_no_sig.empty())
+                        std::memcpy(&dest[0], src_no_sig.data(), src_no_sig.size() * sizeof(SourceCharType));
+                    return;
+                }
+            }
+
+            return dest_converter.convertFromPivot(src, dest, ensure_src_signature, trim_dest_signature);
+        }
+    }
+
+    if constexpr (sizeof(DestinationCharType) == sizeof(ConverterPivotWideCharType)) {
+        if (dest_converter.isPivotEncoding())
+            return src_converter.convertToPivot(src, dest, ensure_src_signature, trim_dest_signature);
+    }
+
 #if defined(WORKAROUND_ICU_USE_EXPLICIT_PIVOTING)
     src_converter.convertToPivot(src, pivot, ensure_src_signature, false);
     dest_converter.convertFromPivot(make_string_view(pivot), dest, true, trim_dest_signature);
@@ -522,7 +563,7 @@ inline void convertEncoding(
         bool dest_signature_trimmed = false;
 
         // If signature must be prepended to the encoded string before decoding, we feed it to ucnv_convertEx() separately, to avoid heavy copying.
-        if (ensure_src_signature) {
+        if (ensure_src_signature && !src_converter.encoded_signature_to_prepend_.empty()) {
             auto src_no_sig = src_converter.consumeEncodedSignature(src);
             if (src_no_sig.size() == src.size()) {
                 auto * target_prev = target;